@@ -0,0 +1,85 @@
+#ifndef BITBOARD_HPP
+#define BITBOARD_HPP
+
+#include "grid.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct BfsSummary
+{
+    int32_t farthest = NO_CELL;     // a reachable cell at the largest distance
+    int32_t max_distance = -1;
+    int64_t reached = 0;
+    int32_t target_distance = -1;   // sweep() only; -1 when the target is unreachable
+};
+
+struct DistanceMap : BfsSummary
+{
+    std::vector<int32_t> distance;  // per grid index, -1 where unreachable
+};
+
+// The passages of a Grid as bitmaps, one bit per cell and each row padded to
+// whole 64-bit words: bit x % 64 of word (y, x / 64) is set when cell (x, y)
+// is open to the right (east) or downwards (south). Searches over it move a
+// whole word of cells per step with shifts and masks. Cells passed in and
+// returned are grid indices in the grid's own layout; only the bitmaps
+// returned by reachable() are in the board's row order.
+//
+// The board is a snapshot; rebuild it after the walls change.
+class PassageBitboard
+{
+public:
+    explicit PassageBitboard(const Grid& grid);
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    int words_per_row() const { return words_per_row_; }
+    size_t word_count() const { return east_.size(); }
+    size_t word_of(int x, int y) const { return static_cast<size_t>(y) * words_per_row_ + x / 64; }
+
+    const std::vector<uint64_t>& east() const { return east_; }
+    const std::vector<uint64_t>& south() const { return south_; }
+
+    // Every cell connected to `source`, in the board's bit layout. A word
+    // worklist flood: each word closes its horizontal runs at once with a
+    // logarithmic fill, and only words that gained cells are revisited.
+    std::vector<uint64_t> reachable(int32_t source) const;
+
+    // Breadth-first distances from `source`. Each level advances only the
+    // words holding frontier cells, so thin corridors stay cheap.
+    DistanceMap distances(int32_t source) const;
+
+    // The same search keeping only its visited bits, one per cell: the
+    // farthest cell and the distance to `target`, for grids too large for a
+    // distance map. Once *is_running reads false the sweep stops at the
+    // next level and returns an incomplete summary.
+    BfsSummary sweep(int32_t source, int32_t target = NO_CELL, const std::atomic<bool>* is_running = nullptr) const;
+
+private:
+    template <class Discover>
+    BfsSummary search(int32_t source, Discover&& discover, const std::atomic<bool>* is_running = nullptr) const;
+
+    // Conversions between grid indices and the board's y * width + x.
+    int32_t board_cell(int32_t cell) const
+    {
+        if (cell == NO_CELL || layout_.kind() == GridLayout::RowMajor) return cell;
+        return layout_.y_of(cell) * width_ + layout_.x_of(cell);
+    }
+    int32_t grid_cell(int32_t cell) const
+    {
+        if (cell == NO_CELL || layout_.kind() == GridLayout::RowMajor) return cell;
+        return layout_.index(cell % width_, cell / width_);
+    }
+
+    CellLayout layout_;
+    int width_ = 0;
+    int height_ = 0;
+    int words_per_row_ = 0;
+    std::vector<uint64_t> east_;
+    std::vector<uint64_t> south_;
+};
+
+#endif // BITBOARD_HPP
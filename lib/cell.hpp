@@ -1,26 +1,61 @@
 #ifndef CELL_HPP
 #define CELL_HPP
 
-#include <vector>
+#include <cstdint>
 
+// Default grid size used by the visualiser when no size is given.
 #define GRID_WIDTH 25
 #define GRID_HEIGHT 25
 
-enum class CellType
+enum class CellType : uint8_t
 {
     Empty, Start, End, Visited, Path, Frontier
 };
 
+// Wall directions; each one is also the bit position of that wall in the mask.
+enum Direction
+{
+    DIR_TOP = 0, DIR_RIGHT = 1, DIR_BOTTOM = 2, DIR_LEFT = 3
+};
+
+constexpr int opposite(int dir) { return (dir + 2) & 3; }
+
+constexpr uint8_t ALL_WALLS = 0x0F;
+constexpr int32_t NO_CELL = -1;
+
+// One byte per cell: bits 0-3 hold the wall mask (top, right, bottom, left),
+// bit 4 the visited flag and bits 5-7 the CellType.
 struct Cell
 {
-    CellType type = CellType::Empty;
-    int x, y;
-    // top, right, bottom, left
-    bool walls[4] = {true, true, true, true};
-
-    bool visited = false;
-    Cell* parent = nullptr;
-    std::vector<Cell*> neighbours;
+    static constexpr uint8_t VISITED_BIT = 0x10;
+    static constexpr int TYPE_SHIFT = 5;
+
+    uint8_t bits = ALL_WALLS;
+
+    uint8_t walls() const { return bits & ALL_WALLS; }
+    bool has_wall(int dir) const { return bits & (1u << dir); }
+    void set_wall(int dir, bool present)
+    {
+        if (present) bits |= (1u << dir);
+        else bits &= ~(1u << dir);
+    }
+
+    void set_walls(uint8_t mask) { bits = (bits & ~ALL_WALLS) | (mask & ALL_WALLS); }
+
+    bool visited() const { return bits & VISITED_BIT; }
+    void set_visited(bool value)
+    {
+        if (value) bits |= VISITED_BIT;
+        else bits &= ~VISITED_BIT;
+    }
+
+    CellType type() const { return static_cast<CellType>(bits >> TYPE_SHIFT); }
+    void set_type(CellType type)
+    {
+        bits = (bits & (ALL_WALLS | VISITED_BIT)) | (static_cast<uint8_t>(type) << TYPE_SHIFT);
+    }
 };
 
+static_assert(sizeof(Cell) == 1, "Cell must stay one byte");
+
 #endif // CELL_HPP
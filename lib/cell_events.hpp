@@ -0,0 +1,71 @@
+#ifndef CELL_EVENTS_HPP
+#define CELL_EVENTS_HPP
+
+#include "cell.hpp"
+#include "spsc_ring.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// New state of one cell. cell == NO_CELL means every cell was set to `state`.
+struct CellEvent
+{
+    int32_t cell;
+    Cell state;
+};
+
+// Receives the changes an animated algorithm publishes through its Grid.
+class CellEventSink
+{
+public:
+    virtual ~CellEventSink() = default;
+    virtual void publish(const CellEvent& event) = 0;
+};
+
+// Carries cell changes from an algorithm thread to the visualiser. The
+// algorithm works on its own Grid and publishes every change; the renderer
+// drains a batch each frame and applies it to the grid it draws, so the two
+// threads never touch the same cells. A full ring blocks the publisher, which
+// is what paces an animation: it runs exactly as fast as it is drained.
+class CellEventChannel : public CellEventSink
+{
+public:
+    explicit CellEventChannel(size_t capacity = 1 << 12) : ring_(capacity) {}
+
+    // Producer side. Waits while the ring is full; once the channel has been
+    // closed, events are dropped instead so a cancelled algorithm never hangs.
+    void publish(const CellEvent& event) override
+    {
+        int attempts = 0;
+        while (!ring_.try_push(event)) {
+            if (closed_.load(std::memory_order_acquire)) return;
+            if (++attempts < 64) std::this_thread::yield();
+            else std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+
+    // Consumer side: applies up to max_events queued events in order.
+    template <class Apply>
+    size_t drain(Apply apply, size_t max_events)
+    {
+        return ring_.consume(apply, max_events);
+    }
+
+    // Consumer side. open() empties the ring for a new run; close() releases
+    // a publisher blocked on a full ring.
+    void open()
+    {
+        ring_.clear();
+        closed_.store(false, std::memory_order_release);
+    }
+    void close() { closed_.store(true, std::memory_order_release); }
+
+    // Producer side: true once the consumer has stopped listening.
+    bool closed() const { return closed_.load(std::memory_order_acquire); }
+
+private:
+    SpscRing<CellEvent> ring_;
+    std::atomic<bool> closed_{false};
+};
+
+#endif // CELL_EVENTS_HPP
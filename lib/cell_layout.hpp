@@ -0,0 +1,98 @@
+#ifndef CELL_LAYOUT_HPP
+#define CELL_LAYOUT_HPP
+
+#include "cell.hpp"
+#include "morton.hpp"
+
+#include <cstdint>
+
+enum class GridLayout
+{
+    RowMajor,  // y * width + x
+    Tiled      // 64x64 tiles in row-major order, Morton order inside each tile
+};
+
+// Maps cell coordinates to array indices and back for one grid shape. Grid
+// holds one and forwards its indexing API to it; code that keeps cell
+// indices apart from the grid (bitboards, the renderer) keeps a copy.
+//
+// Row-major is the default and puts the cell above a row's width away,
+// which for wide grids makes every vertical step a cache miss, and past a
+// few thousand columns a TLB miss as well. The tiled layout keeps each 64x64
+// tile in one 4 KiB page, and Morton order inside the tile puts every 8x8
+// block in one 64-byte cache line, so a step in any direction usually stays
+// in the same line and almost always in the same page. Its width and height
+// must be multiples of 64.
+class CellLayout
+{
+public:
+    static constexpr int TILE_BITS = 6;
+    static constexpr int TILE_SIDE = 1 << TILE_BITS;
+    static constexpr int32_t TILE_CELLS = TILE_SIDE * TILE_SIDE;
+
+    CellLayout() = default;
+    // Throws std::invalid_argument if a tiled layout does not fit the size.
+    CellLayout(int width, int height, GridLayout kind);
+
+    GridLayout kind() const { return tiled_ ? GridLayout::Tiled : GridLayout::RowMajor; }
+
+    int32_t index(int x, int y) const
+    {
+        if (!tiled_) return static_cast<int32_t>(y) * width_ + x;
+        int32_t tile = (y >> TILE_BITS) * tiles_x_ + (x >> TILE_BITS);
+        return (tile << (2 * TILE_BITS))
+               | static_cast<int32_t>(morton_encode(static_cast<uint32_t>(x & (TILE_SIDE - 1)),
+                                                    static_cast<uint32_t>(y & (TILE_SIDE - 1))));
+    }
+
+    int x_of(int32_t i) const
+    {
+        if (!tiled_) return i % width_;
+        return ((i >> (2 * TILE_BITS)) % tiles_x_) * TILE_SIDE
+               + static_cast<int>(morton_x(static_cast<uint32_t>(i & LOCAL_MASK)));
+    }
+
+    int y_of(int32_t i) const
+    {
+        if (!tiled_) return i / width_;
+        return ((i >> (2 * TILE_BITS)) / tiles_x_) * TILE_SIDE
+               + static_cast<int>(morton_y(static_cast<uint32_t>(i & LOCAL_MASK)));
+    }
+
+    // Index of the neighbour of `i` in direction `dir`, which must exist.
+    int32_t step(int32_t i, int dir) const
+    {
+        if (!tiled_) return i + offsets_[dir];
+
+        // Morton increment and decrement: filling the other axis' bits with
+        // ones (or clearing them) lets the carry (or borrow) run straight
+        // through them. One that leaves the tile moves to the next tile.
+        const int32_t own = (dir & 1) ? LOCAL_X : LOCAL_Y;
+        const int32_t other = LOCAL_MASK ^ own;
+        const int32_t local = i & LOCAL_MASK;
+        int32_t base = i - local;
+        int32_t moved;
+        if (dir == DIR_RIGHT || dir == DIR_BOTTOM) {
+            moved = (local | other) + 1;
+            if (moved > LOCAL_MASK) base += offsets_[dir];
+        } else {
+            moved = (local & own) - 1;
+            if (moved < 0) base -= offsets_[dir];
+        }
+        return base | (moved & own) | (local & other);
+    }
+
+private:
+    static constexpr int32_t LOCAL_MASK = TILE_CELLS - 1;
+    static constexpr int32_t LOCAL_X = static_cast<int32_t>(MORTON_EVEN_BITS & LOCAL_MASK);
+    static constexpr int32_t LOCAL_Y = static_cast<int32_t>(MORTON_ODD_BITS & LOCAL_MASK);
+
+    int width_ = 0;
+    bool tiled_ = false;
+    int tiles_x_ = 0;
+    // Row-major: the index offset of each direction. Tiled: the index
+    // distance to the next tile in that direction.
+    int32_t offsets_[4] = {0, 0, 0, 0};
+};
+
+#endif // CELL_LAYOUT_HPP
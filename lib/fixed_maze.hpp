@@ -0,0 +1,338 @@
+#ifndef FIXED_MAZE_HPP
+#define FIXED_MAZE_HPP
+
+#include "grid.hpp"
+#include "maze_creators.hpp"
+#include "maze_solvers.hpp"
+#include "perf_counters.hpp"
+#include "rng.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Neighbourhood policies for FixedMaze. Each lists its directions in wall-bit
+// order as (dx, dy) steps, which may depend on the row, and pairs every
+// direction with its opposite.
+
+// Top, right, bottom, left: the Direction order of Grid.
+struct FourConnected
+{
+    static constexpr int directions = 4;
+    static constexpr std::array<int8_t, 4> DX{0, 1, 0, -1};
+    static constexpr std::array<int8_t, 4> DY{-1, 0, 1, 0};
+
+    static constexpr int dx(int dir, int) { return DX[dir]; }
+    static constexpr int dy(int dir, int) { return DY[dir]; }
+    static constexpr int opposite(int dir) { return (dir + 2) % 4; }
+};
+
+// Clockwise from the top, diagonals included.
+struct EightConnected
+{
+    static constexpr int directions = 8;
+    static constexpr std::array<int8_t, 8> DX{0, 1, 1, 1, 0, -1, -1, -1};
+    static constexpr std::array<int8_t, 8> DY{-1, -1, 0, 1, 1, 1, 0, -1};
+
+    static constexpr int dx(int dir, int) { return DX[dir]; }
+    static constexpr int dy(int dir, int) { return DY[dir]; }
+    static constexpr int opposite(int dir) { return (dir + 4) % 8; }
+};
+
+// Hexagons in rows, odd rows shifted half a cell right. Clockwise from the
+// top right: NE, E, SE, SW, W, NW.
+struct Hex
+{
+    static constexpr int directions = 6;
+    static constexpr std::array<int8_t, 6> DX_EVEN{0, 1, 0, -1, -1, -1};
+    static constexpr std::array<int8_t, 6> DX_ODD{1, 1, 1, 0, -1, 0};
+    static constexpr std::array<int8_t, 6> DY{-1, 0, 1, 1, 0, -1};
+
+    static constexpr int dx(int dir, int y) { return (y & 1) ? DX_ODD[dir] : DX_EVEN[dir]; }
+    static constexpr int dy(int dir, int) { return DY[dir]; }
+    static constexpr int opposite(int dir) { return (dir + 3) % 6; }
+};
+
+// neighbours[i][dir] is the cell next to row-major cell i, or NO_CELL past
+// the border. Built by the compiler; a FixedMaze never checks bounds.
+template <int W, int H, class Neighbourhood, class Index>
+constexpr std::array<std::array<Index, Neighbourhood::directions>, W * H> fixed_neighbour_table()
+{
+    std::array<std::array<Index, Neighbourhood::directions>, W * H> table{};
+    for (int y = 0; y < H; ++y) {
+        for (int x = 0; x < W; ++x) {
+            for (int dir = 0; dir < Neighbourhood::directions; ++dir) {
+                int nx = x + Neighbourhood::dx(dir, y);
+                int ny = y + Neighbourhood::dy(dir, y);
+                bool inside = nx >= 0 && nx < W && ny >= 0 && ny < H;
+                table[y * W + x][dir] = static_cast<Index>(inside ? ny * W + nx : NO_CELL);
+            }
+        }
+    }
+    return table;
+}
+
+// Maze of a size fixed at compile time, for batches of many small mazes.
+// Everything lives in std::arrays inside the object, a few KB up to 64x64,
+// so a whole generate-and-solve stays in L1; neighbours come from a table
+// built at compile time, and the loops over the directions are unrolled
+// with the direction as a constant. Any neighbourhood policy above works;
+// with FourConnected the walls use Grid's bits, and the create_fixed_* and
+// solve_fixed_bfs functions below put the kernels behind the Grid API.
+template <int W, int H, class Neighbourhood = FourConnected>
+class FixedMaze
+{
+public:
+    // The scratch arrays live on the stack of whichever thread runs a
+    // kernel, so sizes stop where 16-bit cell numbers do, which keeps a
+    // call under 128 KB of stack.
+    static_assert(W > 0 && H > 0 && W * H <= INT16_MAX, "FixedMaze is meant for small grids");
+    static_assert(Neighbourhood::directions <= 8, "walls must fit in a byte");
+
+    static constexpr int width = W;
+    static constexpr int height = H;
+    static constexpr int32_t size = W * H;
+    static constexpr int directions = Neighbourhood::directions;
+    static constexpr uint8_t CLOSED = static_cast<uint8_t>((1u << directions) - 1);
+
+    // Row-major cell numbers.
+    using Index = int16_t;
+
+    static constexpr int32_t index(int x, int y) { return y * W + x; }
+    static constexpr int32_t neighbour(int32_t i, int dir) { return NEIGHBOURS[i][dir]; }
+
+    FixedMaze() { reset(); }
+
+    void reset() { walls_.fill(CLOSED); }
+    uint8_t walls(int32_t i) const { return walls_[i]; }
+    bool has_wall(int32_t i, int dir) const { return walls_[i] & (1u << dir); }
+    // The neighbour in direction `dir` must exist.
+    void remove_wall(int32_t i, int dir)
+    {
+        walls_[i] &= static_cast<uint8_t>(~(1u << dir));
+        walls_[NEIGHBOURS[i][dir]] &= static_cast<uint8_t>(~(1u << Neighbourhood::opposite(dir)));
+    }
+
+    // Recursive backtracker and randomised Prim, carving from `start`. They
+    // make the same choices with the same Rng draws as create_dfs_maze and
+    // create_bfs_maze, so with FourConnected the mazes match theirs.
+    void generate_dfs(uint64_t seed, int32_t start = 0)
+    {
+        reset();
+        Rng rng(seed);
+        std::array<bool, W * H> visited{};
+        std::array<Index, W * H> stack;
+        int32_t top = 0;
+
+        visited[start] = true;
+        stack[top++] = static_cast<Index>(start);
+        while (top > 0) {
+            int32_t current = stack[top - 1];
+            int choices[directions];
+            int count = 0;
+            each_direction([&](auto dir) {
+                int32_t next = NEIGHBOURS[current][dir];
+                if (next != NO_CELL && !visited[next]) choices[count++] = dir;
+            });
+            if (count == 0) {
+                --top;
+                continue;
+            }
+            int dir = choices[rng.below(static_cast<uint32_t>(count))];
+            int32_t chosen = NEIGHBOURS[current][dir];
+            remove_wall(current, dir);
+            visited[chosen] = true;
+            stack[top++] = static_cast<Index>(chosen);
+        }
+    }
+
+    void generate_prim(uint64_t seed, int32_t start = 0)
+    {
+        reset();
+        Rng rng(seed);
+        std::array<bool, W * H> visited{};
+        std::array<bool, W * H> in_frontier{};
+        std::array<Index, W * H> frontier;
+        int32_t frontier_size = 0;
+
+        auto add_neighbours = [&](int32_t cell) {
+            each_direction([&](auto dir) {
+                int32_t next = NEIGHBOURS[cell][dir];
+                if (next != NO_CELL && !visited[next] && !in_frontier[next]) {
+                    in_frontier[next] = true;
+                    frontier[frontier_size++] = static_cast<Index>(next);
+                }
+            });
+        };
+
+        visited[start] = true;
+        add_neighbours(start);
+        while (frontier_size > 0) {
+            uint32_t pick = rng.below(static_cast<uint32_t>(frontier_size));
+            int32_t current = frontier[pick];
+            frontier[pick] = frontier[--frontier_size];
+
+            int choices[directions];
+            int count = 0;
+            each_direction([&](auto dir) {
+                int32_t next = NEIGHBOURS[current][dir];
+                if (next != NO_CELL && visited[next]) choices[count++] = dir;
+            });
+            if (count > 0) remove_wall(current, choices[rng.below(static_cast<uint32_t>(count))]);
+            visited[current] = true;
+            add_neighbours(current);
+        }
+    }
+
+    // Breadth-first search in the order of solve_maze's BFS. Fills `path`
+    // with start..end inclusive, or leaves it empty when end is unreachable,
+    // and returns the number of cells expanded. Reusing `path` across calls
+    // avoids allocating.
+    int64_t solve_bfs(int32_t start, int32_t end, std::vector<int32_t>& path) const
+    {
+        constexpr uint8_t NO_PARENT = 0xFF;
+        constexpr uint8_t ROOT = 0xFE;
+        std::array<uint8_t, W * H> parent;
+        parent.fill(NO_PARENT);
+        std::array<Index, W * H> queue;
+        int32_t head = 0;
+        int32_t tail = 0;
+        int64_t expanded = 0;
+        path.clear();
+
+        parent[start] = ROOT;
+        queue[tail++] = static_cast<Index>(start);
+        while (head < tail) {
+            int32_t current = queue[head++];
+            ++expanded;
+            if (current == end) {
+                // Measure the path first so it is written in order, into one
+                // allocation at most.
+                int32_t length = 1;
+                for (int32_t cell = end; cell != start; cell = NEIGHBOURS[cell][parent[cell]]) ++length;
+                path.resize(static_cast<size_t>(length));
+                int32_t cell = end;
+                for (int32_t k = length - 1; k > 0; --k) {
+                    path[k] = cell;
+                    cell = NEIGHBOURS[cell][parent[cell]];
+                }
+                path[0] = start;
+                return expanded;
+            }
+            uint8_t open = static_cast<uint8_t>(~walls_[current]);
+            each_direction([&](auto dir) {
+                if (!(open & (1u << dir))) return;
+                int32_t next = NEIGHBOURS[current][dir];
+                if (parent[next] != NO_PARENT) return;
+                parent[next] = static_cast<uint8_t>(Neighbourhood::opposite(dir));
+                queue[tail++] = static_cast<Index>(next);
+            });
+        }
+        return expanded;
+    }
+
+    // FourConnected only: walls to and from a W x H Grid in any layout, and
+    // the cell numbers of one in the other's.
+    static int32_t cell_of(const Grid& grid, int32_t grid_cell) { return index(grid.x_of(grid_cell), grid.y_of(grid_cell)); }
+    static int32_t grid_cell(const Grid& grid, int32_t cell) { return grid.index(cell % W, cell / W); }
+
+    void load(const Grid& grid)
+    {
+        static_assert(std::is_same<Neighbourhood, FourConnected>::value, "Grid cells have four walls");
+        for (int y = 0; y < H; ++y) {
+            for (int x = 0; x < W; ++x) walls_[index(x, y)] = grid[grid.index(x, y)].walls();
+        }
+    }
+    // Resets the grid, then sets the walls and marks every cell visited, as
+    // a generator leaves them.
+    void store(Grid& grid) const
+    {
+        static_assert(std::is_same<Neighbourhood, FourConnected>::value, "Grid cells have four walls");
+        grid.reset();
+        for (int y = 0; y < H; ++y) {
+            for (int x = 0; x < W; ++x) {
+                Cell& cell = grid[grid.index(x, y)];
+                cell.set_walls(walls_[index(x, y)]);
+                cell.set_visited(true);
+            }
+        }
+    }
+
+private:
+    static constexpr auto NEIGHBOURS = fixed_neighbour_table<W, H, Neighbourhood, Index>();
+
+    // Calls body(std::integral_constant<int, dir>) for every direction in
+    // order, unrolled, so each call sees its direction as a constant.
+    template <class Body, int... Dirs>
+    static void each_direction(Body&& body, std::integer_sequence<int, Dirs...>)
+    {
+        (body(std::integral_constant<int, Dirs>{}), ...);
+    }
+    template <class Body>
+    static void each_direction(Body&& body)
+    {
+        each_direction(body, std::make_integer_sequence<int, directions>{});
+    }
+
+    std::array<uint8_t, W * H> walls_;
+};
+
+// Drop-in forms of create_dfs_maze, create_bfs_maze and solve_maze's BFS
+// with the same signatures and results, running the FixedMaze kernels when
+// the grid is W x H. Other sizes, and animated runs, which publish every
+// step, take the dynamic path.
+template <int W, int H>
+void create_fixed_dfs_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running)
+{
+    if (is_running || grid.width() != W || grid.height() != H) {
+        create_dfs_maze(grid, seed, start_cell, end_cell, is_running);
+        return;
+    }
+    PerfTimer timer(PerfPhase::Generate, "dfs-fixed");
+    FixedMaze<W, H> maze;
+    maze.generate_dfs(seed, start_cell == NO_CELL ? 0 : maze.cell_of(grid, start_cell));
+    maze.store(grid);
+    if (start_cell != NO_CELL) grid[start_cell].set_type(CellType::Start);
+    if (end_cell != NO_CELL) grid[end_cell].set_type(CellType::End);
+    PerfTally().visit(W * H - 1);
+}
+
+template <int W, int H>
+void create_fixed_prim_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running)
+{
+    if (is_running || grid.width() != W || grid.height() != H) {
+        create_bfs_maze(grid, seed, start_cell, end_cell, is_running);
+        return;
+    }
+    PerfTimer timer(PerfPhase::Generate, "bfs-fixed");
+    FixedMaze<W, H> maze;
+    maze.generate_prim(seed, start_cell == NO_CELL ? 0 : maze.cell_of(grid, start_cell));
+    maze.store(grid);
+    if (start_cell != NO_CELL) grid[start_cell].set_type(CellType::Start);
+    if (end_cell != NO_CELL) grid[end_cell].set_type(CellType::End);
+    PerfTally().visit(W * H - 1);
+}
+
+template <int W, int H>
+SolveResult solve_fixed_bfs(const Grid& grid, int32_t start_cell, int32_t end_cell)
+{
+    if (grid.width() != W || grid.height() != H) return solve_maze(grid, start_cell, end_cell, SolveStrategy::BFS);
+    if (start_cell == NO_CELL || end_cell == NO_CELL) return {};
+    PerfTimer timer(PerfPhase::Solve, "bfs-fixed");
+    FixedMaze<W, H> maze;
+    maze.load(grid);
+    SolveResult result;
+    result.expanded = maze.solve_bfs(maze.cell_of(grid, start_cell), maze.cell_of(grid, end_cell), result.path);
+    for (int32_t& cell : result.path) cell = maze.grid_cell(grid, cell);
+    if (!grid.weighted()) {
+        result.cost = result.path.empty() ? 0 : static_cast<int64_t>(result.path.size()) - 1;
+    } else {
+        for (size_t i = 1; i < result.path.size(); ++i) result.cost += grid.cost(result.path[i]);
+    }
+    PerfTally().visit(result.expanded);
+    return result;
+}
+
+#endif // FIXED_MAZE_HPP
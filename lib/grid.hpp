@@ -0,0 +1,131 @@
+#ifndef GRID_HPP
+#define GRID_HPP
+
+#include "cell.hpp"
+#include "cell_layout.hpp"
+#include <vector>
+#include <cstdint>
+
+class CellEventSink;
+
+// Runtime-sized maze grid stored as one contiguous array of cells, row-major
+// by default or in 64x64 Morton-ordered tiles (see CellLayout). Cells are
+// addressed by int32 indices, so a grid holds at most INT32_MAX cells. Every
+// index below size() is a cell, but only index(), x_of(), y_of() and the
+// neighbour functions know where it lies: code that walks rows must go
+// through index(x, y) rather than assume y * width + x.
+class Grid
+{
+public:
+    Grid() = default;
+    Grid(int width, int height, GridLayout layout = GridLayout::RowMajor);
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    int32_t size() const { return static_cast<int32_t>(cells_.size()); }
+    const CellLayout& layout() const { return layout_; }
+
+    int32_t index(int x, int y) const { return layout_.index(x, y); }
+    int x_of(int32_t i) const { return layout_.x_of(i); }
+    int y_of(int32_t i) const { return layout_.y_of(i); }
+    bool in_bounds(int x, int y) const { return x >= 0 && x < width_ && y >= 0 && y < height_; }
+
+    // Index of the cell next to `i` in direction `dir`, or NO_CELL past the border.
+    int32_t neighbour(int32_t i, int dir) const
+    {
+        int x = x_of(i);
+        int y = y_of(i);
+        bool inside;
+        switch (dir)
+        {
+            case DIR_TOP: inside = y > 0; break;
+            case DIR_RIGHT: inside = x < width_ - 1; break;
+            case DIR_BOTTOM: inside = y < height_ - 1; break;
+            default: inside = x > 0; break;
+        }
+        return inside ? layout_.step(i, dir) : NO_CELL;
+    }
+
+    // All four neighbours of `i` indexed by direction, NO_CELL past the border.
+    // Cheaper than four neighbour() calls since the coordinates are derived once.
+    void neighbours(int32_t i, int32_t out[4]) const
+    {
+        int x = x_of(i);
+        int y = y_of(i);
+        out[DIR_TOP] = y > 0 ? layout_.step(i, DIR_TOP) : NO_CELL;
+        out[DIR_RIGHT] = x < width_ - 1 ? layout_.step(i, DIR_RIGHT) : NO_CELL;
+        out[DIR_BOTTOM] = y < height_ - 1 ? layout_.step(i, DIR_BOTTOM) : NO_CELL;
+        out[DIR_LEFT] = x > 0 ? layout_.step(i, DIR_LEFT) : NO_CELL;
+    }
+
+    // Neighbour in direction `dir` without a bounds check. Only valid across an
+    // open wall, since border walls are never removed.
+    int32_t open_neighbour(int32_t i, int dir) const { return layout_.step(i, dir); }
+
+    // Opens the wall between `i` and its neighbour in direction `dir`, on both
+    // sides. The neighbour must exist.
+    void remove_wall(int32_t i, int dir)
+    {
+        cells_[i].set_wall(dir, false);
+        cells_[layout_.step(i, dir)].set_wall(opposite(dir), false);
+    }
+
+    // Closes the wall between `i` and its neighbour in direction `dir`, on
+    // both sides. The neighbour must exist.
+    void add_wall(int32_t i, int dir)
+    {
+        cells_[i].set_wall(dir, true);
+        cells_[layout_.step(i, dir)].set_wall(opposite(dir), true);
+    }
+
+    Cell& operator[](int32_t i) { return cells_[i]; }
+    const Cell& operator[](int32_t i) const { return cells_[i]; }
+    Cell& at(int x, int y) { return cells_[index(x, y)]; }
+    const Cell& at(int x, int y) const { return cells_[index(x, y)]; }
+
+    Cell* data() { return cells_.data(); }
+    const Cell* data() const { return cells_.data(); }
+
+    // Restores every cell to four walls, unvisited and Empty. Costs are
+    // terrain rather than maze, so they stay.
+    void reset();
+
+    // Terrain costs: entering cell i costs cost(i), from 1 to 255. A new grid
+    // is unweighted, every cost 1 with no storage behind it. The weighted
+    // solvers add up costs; BFS and the other step-counting searches ignore
+    // them. min_cost() and max_cost() bound every cell's cost; set_costs()
+    // makes them exact, set_cost() only widens them. Path costs are int32, so
+    // cells times max_cost() should stay below 2^31.
+    bool weighted() const { return !costs_.empty(); }
+    uint8_t cost(int32_t i) const { return costs_.empty() ? 1 : costs_[i]; }
+    const uint8_t* costs() const { return costs_.data(); }
+    int min_cost() const { return min_cost_; }
+    int max_cost() const { return max_cost_; }
+    void set_cost(int32_t i, uint8_t cost);
+    // One cost per cell, each at least 1; throws std::invalid_argument otherwise.
+    void set_costs(std::vector<uint8_t> costs);
+    void clear_costs();
+
+    // Animated algorithms call publish(i) after changing cell i, which
+    // forwards its new state to the attached sink, if any. A copied grid
+    // shares the sink pointer.
+    void set_event_sink(CellEventSink* sink) { events_ = sink; }
+    void publish(int32_t i) const
+    {
+        if (events_) publish_event(i);
+    }
+
+private:
+    void publish_event(int32_t i) const;
+
+    int width_ = 0;
+    int height_ = 0;
+    CellLayout layout_;
+    std::vector<Cell> cells_;
+    std::vector<uint8_t> costs_;  // empty while unweighted
+    int min_cost_ = 1;
+    int max_cost_ = 1;
+    CellEventSink* events_ = nullptr;
+};
+
+#endif // GRID_HPP
@@ -0,0 +1,53 @@
+#ifndef GRID_SNAPSHOTS_HPP
+#define GRID_SNAPSHOTS_HPP
+
+#include "cell_events.hpp"
+#include "grid.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Immutable copy of a grid's cells after the first `events` events of a run.
+struct GridSnapshot
+{
+    int64_t events;
+    std::vector<Cell> cells;
+};
+
+// Double-buffered snapshots of an animated run, for a reader on another
+// thread. It sits between the algorithm's Grid and the sink that carries
+// its events: every event is forwarded, then applied to a back buffer, and
+// every `interval` events a copy of the back buffer becomes the front
+// buffer through an atomic pointer swap. The writer never waits for the
+// reader and the reader never sees a snapshot change under it, so the
+// whole-grid copies happen on the algorithm's thread, not the reader's.
+class GridSnapshots : public CellEventSink
+{
+public:
+    GridSnapshots() = default;
+
+    GridSnapshots(const GridSnapshots&) = delete;
+    GridSnapshots& operator=(const GridSnapshots&) = delete;
+
+    // Writer side, before the first event: the back buffer starts as a copy
+    // of `initial`, and events go on to `downstream`. interval must be > 0.
+    void attach(const Grid& initial, CellEventSink& downstream, int64_t interval);
+
+    void publish(const CellEvent& event) override;
+
+    // Reader side: the newest snapshot not taken yet, or null. A snapshot is
+    // swapped in after the event that completes it has been forwarded and
+    // before the next one is, so a reader that has just received the event
+    // after a boundary finds that boundary's snapshot here, unless the
+    // writer has since run a whole interval further ahead.
+    std::shared_ptr<const GridSnapshot> take();
+
+private:
+    CellEventSink* downstream_ = nullptr;
+    std::vector<Cell> back_;
+    int64_t interval_ = 0;
+    int64_t events_ = 0;
+    std::shared_ptr<const GridSnapshot> front_;  // only through std::atomic_*
+};
+
+#endif // GRID_SNAPSHOTS_HPP
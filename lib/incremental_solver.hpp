@@ -0,0 +1,72 @@
+#ifndef INCREMENTAL_SOLVER_HPP
+#define INCREMENTAL_SOLVER_HPP
+
+#include "grid.hpp"
+#include "maze_solvers.hpp"
+#include "priority_queues.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Lifelong Planning A* (Koenig and Likhachev) with a zero heuristic, which
+// makes it an incremental Dijkstra rooted at one endpoint. Distances from the
+// root stay valid between queries, so moving the other endpoint only resumes
+// the search, and a wall change re-expands just the cells whose distance it
+// changes. Moving the root endpoint re-roots the search at the other one, so
+// repeated moves of the same marker stay incremental.
+//
+// Paths are the cheapest over the grid's cell costs. Entering a cell costs
+// the same from every side, so the distances from either endpoint differ by
+// a constant along every start-end path and either root finds the same one.
+//
+// The solver reads walls and costs from `grid` on every query; call
+// wall_changed() or cost_changed() after an edit and reset() after
+// rebuilding the maze or its terrain. The grid must outlive the solver.
+class IncrementalSolver
+{
+public:
+    explicit IncrementalSolver(const Grid& grid);
+
+    // Shortest path start..end, repairing the previous search. `expanded`
+    // counts only the cells this call expanded.
+    SolveResult solve(int32_t start_cell, int32_t end_cell);
+
+    // The wall between `cell` and its neighbour in direction `dir` was added
+    // or removed. The repair itself happens on the next solve().
+    void wall_changed(int32_t cell, int dir);
+
+    // The cost of entering `cell` changed.
+    void cost_changed(int32_t cell);
+
+    // Forgets all search state, e.g. after a new maze was generated.
+    void reset();
+
+    // Endpoint the current search is rooted at, or NO_CELL.
+    int32_t root() const { return root_; }
+
+private:
+    static constexpr int32_t UNREACHED = INT32_MAX;
+
+    int32_t key(int32_t cell) const { return g_[cell] < rhs_[cell] ? g_[cell] : rhs_[cell]; }
+    void restart(int32_t root);
+    void touch(int32_t cell);
+    void update_cell(int32_t cell);
+    int64_t compute(int32_t target);
+    std::vector<int32_t> path_to_root(int32_t cell) const;
+
+    const Grid& grid_;
+    // g is the distance settled by the last expansion, rhs the one-step
+    // lookahead through the neighbours; they differ on cells still queued.
+    std::vector<int32_t> g_;
+    std::vector<int32_t> rhs_;
+    // Cells whose g or rhs left UNREACHED, so restarting only clears those.
+    std::vector<uint8_t> touched_;
+    std::vector<int32_t> touched_cells_;
+    // (key, cell); entries whose key no longer matches are skipped on pop.
+    DaryHeap<std::pair<int32_t, int32_t>> open_;
+    int32_t root_ = NO_CELL;
+    int32_t target_ = NO_CELL;
+};
+
+#endif // INCREMENTAL_SOLVER_HPP
@@ -0,0 +1,135 @@
+#ifndef JOB_SCHEDULER_HPP
+#define JOB_SCHEDULER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Reported by Job::get() for a job that was cancelled before it started.
+class JobCancelled : public std::runtime_error
+{
+public:
+    JobCancelled() : std::runtime_error("job cancelled") {}
+};
+
+// Cooperative cancellation for one job, shared by the job and whoever
+// submitted it. The flag reads true while the job should keep going, the
+// convention of the algorithms' is_running parameter, so running() can be
+// passed to them directly; an animated algorithm clears it when it ends.
+class CancelToken
+{
+public:
+    CancelToken() : running_(std::make_shared<std::atomic<bool>>(true)) {}
+
+    void cancel() const { running_->store(false); }
+    bool cancelled() const { return !running_->load(); }
+    std::atomic<bool>* running() const { return running_.get(); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> running_;
+};
+
+// The submitter's side of a job: its result, once there is one, and its
+// cancellation token. Dropping a Job does not wait for it; the job still
+// runs (or, if cancelled first, is skipped) and its result is discarded.
+template <class T>
+class Job
+{
+public:
+    Job() = default;
+
+    bool valid() const { return future_.valid(); }
+    bool ready() const
+    {
+        return future_.valid() && future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+    void wait() const { future_.wait(); }
+
+    // Waits, then returns the result or rethrows what the job threw. Only
+    // one call per job; the Job is empty afterwards.
+    T get() { return future_.get(); }
+
+    void cancel() const { token_.cancel(); }
+    const CancelToken& token() const { return token_; }
+
+private:
+    friend class JobScheduler;
+
+    std::future<T> future_;
+    CancelToken token_;
+};
+
+// Persistent worker threads running submitted jobs in FIFO order. Unlike
+// ThreadPool, which runs the short chunks of parallel loops and lets a
+// waiting caller run queued chunks itself, a job may take seconds, so jobs
+// have their own threads and nobody waiting on a parallel loop ever ends up
+// running one. A job may use the thread pool freely.
+class JobScheduler
+{
+public:
+    // thread_count <= 0 uses two workers, enough to run an animated
+    // algorithm next to an analysis or a file transfer.
+    explicit JobScheduler(int thread_count = 0);
+
+    // Waits for the running jobs. Jobs still queued are dropped, and their
+    // futures report std::future_error (broken promise).
+    ~JobScheduler();
+
+    JobScheduler(const JobScheduler&) = delete;
+    JobScheduler& operator=(const JobScheduler&) = delete;
+
+    int thread_count() const { return static_cast<int>(threads_.size()); }
+
+    // Queues body(token) and returns its Job. A job cancelled before a
+    // worker picks it up never runs, and its get() throws JobCancelled.
+    template <class Body>
+    Job<std::invoke_result_t<Body&, const CancelToken&>> submit(Body&& body)
+    {
+        using Result = std::invoke_result_t<Body&, const CancelToken&>;
+        Job<Result> job;
+        auto promise = std::make_shared<std::promise<Result>>();
+        auto work = std::make_shared<std::decay_t<Body>>(std::forward<Body>(body));
+        job.future_ = promise->get_future();
+        CancelToken token = job.token_;
+        enqueue([promise, work, token]() {
+            if (token.cancelled()) {
+                promise->set_exception(std::make_exception_ptr(JobCancelled()));
+                return;
+            }
+            try {
+                if constexpr (std::is_void_v<Result>) {
+                    (*work)(token);
+                    promise->set_value();
+                } else {
+                    promise->set_value((*work)(token));
+                }
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        });
+        return job;
+    }
+
+private:
+    void enqueue(std::function<void()> task);
+    void worker_loop();
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<std::function<void()>> queue_;
+    bool stopping_ = false;
+};
+
+#endif // JOB_SCHEDULER_HPP
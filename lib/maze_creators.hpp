@@ -1,11 +1,75 @@
 #ifndef MAZE_CREATORS_HPP
 #define MAZE_CREATORS_HPP
 
-#include "cell.hpp"
-#include <vector>
+#include "grid.hpp"
+#include "thread_pool.hpp"
 #include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Every generator is a pure function of its seed: the same seed and grid
+// size always carve the same maze. start_cell / end_cell are grid indices,
+// or NO_CELL when not set.
+void create_dfs_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running);
+void create_bfs_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running);
+
+// Kruskal's algorithm: opens walls in random order whenever they join two
+// separate regions, tracked with a path-compressed union-find.
+void create_kruskal_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running);
+// Wilson's algorithm: loop-erased random walks, which sample uniformly among
+// all spanning trees of the grid.
+void create_wilson_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running);
+// Row-local generators, built on the streaming forms below.
+void create_binary_tree_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running);
+void create_sidewinder_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running);
+void create_eller_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running);
+
+// Receives one finished row at a time, top to bottom; walls[x] is the wall
+// mask of cell (x, y).
+using MazeRowSink = std::function<void(int64_t y, const uint8_t* walls)>;
+
+// Row-streaming generators that keep only O(width) state, so mazes of any
+// height can be produced without holding a Grid. Binary tree and sidewinder
+// carve east/south, so their long corridors run along the bottom and right.
+void stream_binary_tree_maze(int width, int64_t height, uint64_t seed, const MazeRowSink& sink);
+void stream_sidewinder_maze(int width, int64_t height, uint64_t seed, const MazeRowSink& sink);
+void stream_eller_maze(int width, int64_t height, uint64_t seed, const MazeRowSink& sink);
+
+// Tile-parallel generation for very large grids. Each tile_size x tile_size
+// tile is carved as an independent DFS maze with its own Rng stream, then the
+// tiles are joined along a random spanning tree with one opening per tree
+// edge. The result depends only on seed and tile_size, never on the number
+// of threads in the pool.
+void create_parallel_maze(Grid& grid, uint64_t seed, ThreadPool& pool, int tile_size = 256);
+// Registry form: uses default_thread_pool().
+void create_parallel_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running);
+
+// Post-processing for mazes with loops. Both open walls in place and work
+// on the output of any generator; each returns the number of walls opened
+// and, like the generators, is a pure function of the grid and its seed.
+//
+// braid_maze removes `fraction` (0..1) of the dead ends, in random order, by
+// opening one of their walls, preferring a wall shared with another dead end
+// so one opening removes two. At 1 the maze has no dead ends left.
+int64_t braid_maze(Grid& grid, uint64_t seed, double fraction);
+// open_random_walls opens `fraction` of the standing interior walls, chosen
+// uniformly; a few percent already gives a perfect maze many loops.
+int64_t open_random_walls(Grid& grid, uint64_t seed, double fraction);
+
+using MazeCreator = void (*)(Grid&, uint64_t, int32_t, int32_t, std::atomic<bool>*);
+using MazeStreamer = void (*)(int, int64_t, uint64_t, const MazeRowSink&);
+
+struct MazeCreatorInfo
+{
+    const char* name;
+    MazeCreator create;
+    MazeStreamer stream = nullptr;  // set when the generator can stream rows
+};
 
-void create_dfs_maze(std::vector<std::vector<Cell>>& cells, Cell* start_cell, Cell* end_cell, std::atomic<bool>* is_running);
-void create_bfs_maze(std::vector<std::vector<Cell>>& cells, Cell* start_cell, Cell* end_cell, std::atomic<bool>* is_running);
+// All generators by name, for front ends that pick one at runtime.
+const std::vector<MazeCreatorInfo>& maze_creator_list();
+MazeCreator find_maze_creator(const std::string& name);
+const MazeCreatorInfo* find_maze_creator_info(const std::string& name);
 
 #endif // MAZE_CREATORS_HPP
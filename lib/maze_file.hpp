@@ -0,0 +1,126 @@
+#ifndef MAZE_FILE_HPP
+#define MAZE_FILE_HPP
+
+#include "grid.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+// On-disk maze format (.maze):
+//   a 64-byte MazeFileHeader, then `height` rows of (width + 1) / 2 bytes.
+//   Each byte packs two 4-bit wall masks, the even column in the low nibble.
+// Rows are padded to whole bytes so any cell can be found without scanning.
+// Integers are stored little-endian; only little-endian hosts are supported.
+struct MazeFileHeader
+{
+    char magic[4];          // "VMAZ"
+    uint16_t version;
+    uint16_t header_size;   // sizeof(MazeFileHeader), so readers can skip future fields
+    uint32_t width;
+    uint32_t reserved;
+    uint64_t height;
+    uint64_t seed;
+    char generator[32];     // NUL-terminated generator name
+};
+
+static_assert(sizeof(MazeFileHeader) == 64, "MazeFileHeader must stay 64 bytes");
+
+constexpr uint16_t MAZE_FILE_VERSION = 1;
+
+inline int64_t maze_file_row_bytes(int width) { return (static_cast<int64_t>(width) + 1) / 2; }
+
+// Writes a maze row by row, so a streaming generator never has to hold more
+// than one row. Every row must be written before finish(). Errors throw
+// std::runtime_error.
+class MazeFileWriter
+{
+public:
+    MazeFileWriter(const std::string& path, int width, int64_t height, uint64_t seed, const std::string& generator);
+    ~MazeFileWriter();
+
+    MazeFileWriter(const MazeFileWriter&) = delete;
+    MazeFileWriter& operator=(const MazeFileWriter&) = delete;
+
+    // walls[x] is the wall mask of cell (x, y) for the next row y.
+    void write_row(const uint8_t* walls);
+    void finish();
+
+    // Adapter for the stream_*_maze generators.
+    std::function<void(int64_t, const uint8_t*)> sink()
+    {
+        return [this](int64_t, const uint8_t* walls) { write_row(walls); };
+    }
+
+private:
+    std::FILE* file_ = nullptr;
+    std::string path_;
+    int width_;
+    int64_t height_;
+    int64_t rows_written_ = 0;
+    std::vector<uint8_t> packed_;
+};
+
+// Read-only view of a .maze file mapped into memory. Wall masks are read
+// straight from the mapping, so the file is paged in lazily as a search
+// touches it and nothing is copied. Cells use int64 row-major indices, so a
+// file may hold far more cells than a Grid. Errors throw std::runtime_error.
+class MappedMaze
+{
+public:
+    explicit MappedMaze(const std::string& path);
+    ~MappedMaze();
+
+    MappedMaze(MappedMaze&& other) noexcept;
+    MappedMaze& operator=(MappedMaze&& other) noexcept;
+    MappedMaze(const MappedMaze&) = delete;
+    MappedMaze& operator=(const MappedMaze&) = delete;
+
+    int width() const { return width_; }
+    int64_t height() const { return height_; }
+    int64_t size() const { return static_cast<int64_t>(width_) * height_; }
+    uint64_t seed() const { return seed_; }
+    const std::string& generator() const { return generator_; }
+
+    int64_t index(int x, int64_t y) const { return y * width_ + x; }
+
+    // Border walls read as closed whatever the file says, so a damaged file
+    // can never lead open_neighbour() out of the maze.
+    uint8_t walls(int64_t cell) const
+    {
+        int64_t y = cell / width_;
+        int64_t x = cell - y * width_;
+        uint8_t packed = rows_[y * row_bytes_ + x / 2];
+        uint8_t mask = (x & 1) ? packed >> 4 : packed & ALL_WALLS;
+        if (y == 0) mask |= 1u << DIR_TOP;
+        if (x == width_ - 1) mask |= 1u << DIR_RIGHT;
+        if (y == height_ - 1) mask |= 1u << DIR_BOTTOM;
+        if (x == 0) mask |= 1u << DIR_LEFT;
+        return mask;
+    }
+    bool has_wall(int64_t cell, int dir) const { return walls(cell) & (1u << dir); }
+
+    // Neighbour across an open wall; like Grid::open_neighbour, no bounds check.
+    int64_t open_neighbour(int64_t cell, int dir) const { return cell + offsets_[dir]; }
+
+private:
+    void release();
+
+    void* mapping_ = nullptr;
+    size_t mapping_size_ = 0;
+    const uint8_t* rows_ = nullptr;
+    int64_t row_bytes_ = 0;
+    int width_ = 0;
+    int64_t height_ = 0;
+    int64_t offsets_[4] = {0, 0, 0, 0};
+    uint64_t seed_ = 0;
+    std::string generator_;
+};
+
+// Whole-grid helpers built on the writer and the mapping. Files always hold
+// rows; load_maze lays the cells out as asked.
+void save_maze(const Grid& grid, const std::string& path, uint64_t seed, const std::string& generator);
+Grid load_maze(const std::string& path, GridLayout layout = GridLayout::RowMajor);
+
+#endif // MAZE_FILE_HPP
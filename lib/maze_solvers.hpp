@@ -1,10 +1,105 @@
 #ifndef MAZE_SOLVERS_HPP
 #define MAZE_SOLVERS_HPP
 
-#include "cell.hpp"
-#include <vector>
+#include "grid.hpp"
 #include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Dijkstra, A* and Dial find the cheapest path over the grid's cell costs
+// (see Grid::cost); the BFS strategies find the path with the fewest steps.
+// On an unweighted grid all of them return a shortest path.
+enum class SolveStrategy
+{
+    Dijkstra,         // radix heap
+    AStar,            // 4-ary heap ordered by g + Manhattan distance * min cost
+    BFS,
+    BidirectionalBFS, // level-synchronous BFS from both ends
+    Dial,             // bucket queue with one bucket per possible cell cost
+    DeadEndFill       // dead-end filling, then Dijkstra over the cells left
+};
+
+struct SolveResult
+{
+    std::vector<int32_t> path;  // start..end inclusive, empty when unreachable
+    int64_t expanded = 0;       // cells taken off the queue and expanded
+    int64_t cost = 0;           // sum of the costs of the cells entered along the path
+};
+
+// Headless search: reads only the walls, leaves the grid untouched.
+SolveResult solve_maze(const Grid& grid, int32_t start_cell, int32_t end_cell, SolveStrategy strategy);
+
+// Dead-end filling as a preprocessing pass: returns one byte per cell, 1 for
+// cells that cannot lie on any loop-free path between the endpoints. It
+// takes one linear pass and leaves only the solution of a perfect maze, and
+// only the loops and the corridors between them in a braided one.
+std::vector<uint8_t> fill_dead_ends(const Grid& grid, int32_t start_cell, int32_t end_cell);
+
+// Headless search that never enters a cell whose `pruned` byte is set, e.g.
+// the output of fill_dead_ends; the result is the same as without it, with
+// fewer cells expanded. `pruned` must have one entry per cell.
+SolveResult solve_maze(const Grid& grid, int32_t start_cell, int32_t end_cell, SolveStrategy strategy,
+                       const std::vector<uint8_t>& pruned);
+
+// Animated search for the visualiser: marks Frontier/Visited cells while
+// searching and the found path as Path, publishing each change to the grid's
+// event channel. With is_running == nullptr it only marks the path.
+SolveResult solve_maze(Grid& grid, int32_t start_cell, int32_t end_cell, SolveStrategy strategy, std::atomic<bool>* is_running);
+
+class MappedMaze;
+
+struct MappedSolveResult
+{
+    std::vector<int64_t> path;  // start..end inclusive, empty when unreachable
+    int64_t expanded = 0;
+};
+
+// BFS straight over a memory-mapped maze file (see maze_file.hpp), for mazes
+// larger than a Grid can hold. Needs one byte of memory per cell. Start and
+// end outside the maze throw std::invalid_argument.
+MappedSolveResult solve_mapped_maze(const MappedMaze& maze, int64_t start_cell, int64_t end_cell);
+
+struct PathQuery
+{
+    int32_t start_cell;
+    int32_t end_cell;
+};
+
+struct BatchSolveResult
+{
+    std::vector<int32_t> lengths;             // lengths[i] answers queries[i]: passages, -1 when unreachable
+    std::vector<std::vector<int32_t>> paths;  // start..end inclusive, when requested; empty when unreachable
+    int64_t searches = 0;                     // one per distinct start cell
+    int64_t expanded = 0;                     // over all searches
+};
+
+// Shortest paths for many start/end pairs on one maze. Queries are grouped
+// by start cell, and each group is answered by a single BFS that stops as
+// soon as all of its end cells have been reached. Groups run in parallel on
+// the default thread pool. Every running search reuses a scratch buffer
+// whose visited marks are epoch stamps, so nothing is cleared between
+// searches. Paths of long mazes add up quickly; with want_paths false only
+// the lengths are returned.
+BatchSolveResult solve_batch(const Grid& grid, const std::vector<PathQuery>& queries, bool want_paths = true);
+
+void dijkstra_solve(Grid& grid, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running);
+void astar_solve(Grid& grid, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running);
+void dial_solve(Grid& grid, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running);
+void dead_end_fill_solve(Grid& grid, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running);
+void bfs_solve(Grid& grid, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running);
+void bidirectional_solve(Grid& grid, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running);
+
+using MazeSolver = void (*)(Grid&, int32_t, int32_t, std::atomic<bool>*);
+
+struct MazeSolverInfo
+{
+    const char* name;
+    MazeSolver solve;
+    SolveStrategy strategy;
+};
 
-void dijkstra_solve(std::vector<std::vector<Cell>>& cells, Cell* start_cell, Cell* end_cell, std::atomic<bool>* is_running);
+const std::vector<MazeSolverInfo>& maze_solver_list();
+const MazeSolverInfo* find_maze_solver(const std::string& name);
 
 #endif // MAZE_SOLVERS_HPP
@@ -0,0 +1,92 @@
+#ifndef MAZE_STATS_HPP
+#define MAZE_STATS_HPP
+
+#include "grid.hpp"
+#include <atomic>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Shape metrics of a maze. The local counts depend only on each cell's own
+// wall mask, so they are gathered in one pass over the rows and can be taken
+// while a maze streams to disk; the rest need searches and are filled in by
+// analyse_maze.
+struct MazeStats
+{
+    int64_t cells = 0;
+    int64_t passages = 0;          // open walls, each counted once
+    int64_t degree[5] = {};        // cells by number of open sides
+    int64_t straights = 0;         // two-way cells open on opposite sides
+    int64_t turns = 0;             // two-way cells open on adjacent sides
+
+    // Filled by analyse_maze.
+    int64_t branch_cells = 0;      // cells on the runs from each dead end to the next fork
+    int64_t reached = 0;           // cells connected to the first cell searched
+    int32_t diameter = -1;         // passages on the longest shortest path found
+    int32_t diameter_ends[2] = {NO_CELL, NO_CELL};
+    int32_t solution_length = -1;  // passages on the shortest start-end path
+
+    void add_cell(uint8_t walls)
+    {
+        walls &= ALL_WALLS;
+        int open = 4 - __builtin_popcount(walls);
+        ++cells;
+        ++degree[open];
+        passages += !(walls & (1u << DIR_RIGHT)) + !(walls & (1u << DIR_BOTTOM));
+        if (open == 2) {
+            // Opposite openings leave either both vertical or both horizontal walls.
+            if (walls == 0x5 || walls == 0xA) ++straights;
+            else ++turns;
+        }
+    }
+
+    // walls[x] is the wall mask of cell (x, y), as a MazeRowSink receives it.
+    void add_row(const uint8_t* walls, int width)
+    {
+        for (int x = 0; x < width; ++x) add_cell(walls[x]);
+    }
+
+    // Adds the counts of a disjoint part of the same maze.
+    void merge(const MazeStats& other);
+
+    int64_t dead_ends() const { return degree[1]; }
+    int64_t junctions() const { return degree[3] + degree[4]; }
+
+    // Corridors are the maximal runs of two-way cells and the passages
+    // between them: the edges of the graph whose nodes are the dead ends and
+    // junctions. Each such edge ends at two node sides.
+    int64_t corridors() const { return (degree[1] + 3 * degree[3] + 4 * degree[4]) / 2; }
+    double average_corridor() const;  // passages per corridor
+
+    // Average dead-end branch length in cells. Mazes that flow like a river
+    // (depth-first) have few, long side branches; Prim-like mazes have many
+    // short stubs.
+    double river() const;
+
+    // Share of all cells that lie on the solution path.
+    double solution_ratio() const;
+
+    // Connected and free of loops; needs analyse_maze.
+    bool perfect() const { return reached == cells && passages == cells - 1; }
+};
+
+// All metrics for `grid`. The cell pass runs on the default thread pool and
+// the graph metrics take two bitboard sweeps, which keep one bit per cell, so
+// the extra memory stays near 3 bits per cell at any size.
+//
+// The diameter is a double sweep: the farthest cell from `start` (or cell 0),
+// then the farthest cell from that one. It is exact for perfect mazes and a
+// lower bound when there are loops. The solution length is left at -1 when
+// either endpoint is NO_CELL or the end is unreachable.
+//
+// With is_running, the analysis checks it at every row and every sweep
+// level and returns early, with incomplete metrics, once it reads false.
+MazeStats analyse_maze(const Grid& grid, int32_t start = NO_CELL, int32_t end = NO_CELL,
+                       const std::atomic<bool>* is_running = nullptr);
+
+// Human-readable summary, one metric group per line, shared by the front
+// ends. Metrics that were not computed are left out.
+std::vector<std::string> maze_stats_lines(const MazeStats& stats);
+
+#endif // MAZE_STATS_HPP
@@ -1,17 +1,31 @@
 #ifndef MAZE_UTILS_HPP
 #define MAZE_UTILS_HPP
 
-#include "cell.hpp"
+#include "grid.hpp"
 #include <vector>
-#include <random>
 
-extern std::mt19937 g;
+// Up to four neighbour indices, stored inline so enumerating them never allocates.
+struct NeighbourList
+{
+    int32_t cells[4];
+    int count = 0;
 
-bool is_maze_generated(const std::vector<std::vector<Cell>>& cells);
-void cells_reset(std::vector<std::vector<Cell>>& cells);
-void removeWalls(Cell& a, Cell& b);
-std::vector<Cell*> get_neighbours(Cell* current, std::vector<std::vector<Cell>>& cells, bool get_visited);
-std::vector<Cell*> get_neighbours(Cell* current, std::vector<std::vector<Cell>>& cells);
-void add_neighbours_to_frontier(Cell* cell, std::vector<std::vector<Cell>>& cells, std::vector<Cell*>& frontier);
+    void push(int32_t cell) { cells[count++] = cell; }
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+    int32_t operator[](int i) const { return cells[i]; }
+    const int32_t* begin() const { return cells; }
+    const int32_t* end() const { return cells + count; }
+};
+
+bool is_maze_generated(const Grid& grid);
+void cells_reset(Grid& grid);
+void removeWalls(Grid& grid, int32_t a, int32_t b);
+NeighbourList get_neighbours(int32_t current, const Grid& grid, bool get_visited);
+NeighbourList get_neighbours(int32_t current, const Grid& grid);
+// Pushes the unvisited neighbours of `cell` that are not yet in the frontier;
+// in_frontier holds one bit per cell. With mark_cells they are also painted
+// as Frontier for the visualiser.
+void add_neighbours_to_frontier(int32_t cell, Grid& grid, std::vector<int32_t>& frontier, std::vector<bool>& in_frontier, bool mark_cells);
 
 #endif // MAZE_UTILS_HPP
@@ -0,0 +1,57 @@
+#ifndef MORTON_HPP
+#define MORTON_HPP
+
+#include <cstdint>
+
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
+
+// Morton (Z-order) codes interleave the bits of x and y, x in the even bits
+// and y in the odd ones, so cells close in both directions get close codes.
+// With BMI2 (e.g. -march=native on Haswell or later) spreading and gathering
+// the bits is a single pdep or pext; otherwise the usual shift-and-mask
+// ladder does the same in four steps.
+
+constexpr uint32_t MORTON_EVEN_BITS = 0x55555555u;
+constexpr uint32_t MORTON_ODD_BITS = 0xAAAAAAAAu;
+
+// Moves bit k of the low 16 bits of v to bit 2k.
+inline uint32_t morton_spread(uint32_t v)
+{
+#ifdef __BMI2__
+    return _pdep_u32(v, MORTON_EVEN_BITS);
+#else
+    v &= 0x0000FFFFu;
+    v = (v | (v << 8)) & 0x00FF00FFu;
+    v = (v | (v << 4)) & 0x0F0F0F0Fu;
+    v = (v | (v << 2)) & 0x33333333u;
+    v = (v | (v << 1)) & 0x55555555u;
+    return v;
+#endif
+}
+
+// Inverse of morton_spread: gathers the even bits of v into the low 16.
+inline uint32_t morton_compact(uint32_t v)
+{
+#ifdef __BMI2__
+    return _pext_u32(v, MORTON_EVEN_BITS);
+#else
+    v &= 0x55555555u;
+    v = (v | (v >> 1)) & 0x33333333u;
+    v = (v | (v >> 2)) & 0x0F0F0F0Fu;
+    v = (v | (v >> 4)) & 0x00FF00FFu;
+    v = (v | (v >> 8)) & 0x0000FFFFu;
+    return v;
+#endif
+}
+
+inline uint32_t morton_encode(uint32_t x, uint32_t y)
+{
+    return morton_spread(x) | (morton_spread(y) << 1);
+}
+
+inline uint32_t morton_x(uint32_t code) { return morton_compact(code); }
+inline uint32_t morton_y(uint32_t code) { return morton_compact(code >> 1); }
+
+#endif // MORTON_HPP
@@ -0,0 +1,39 @@
+#ifndef PATH_ANALYSIS_HPP
+#define PATH_ANALYSIS_HPP
+
+#include "grid.hpp"
+#include "maze_solvers.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// Path queries that only make sense on mazes with loops (see braid_maze and
+// open_random_walls); on a perfect maze there is exactly one loop-free path
+// between any two cells. Costs are the grid's cell costs, as for Dijkstra.
+
+// Up to `k` loop-free start-end paths in order of increasing cost, by Yen's
+// algorithm. Each new path branches off the previous one at a spur cell;
+// the spur searches are A* runs on a radix heap that avoid the shared root
+// and the branches already taken, guided by exact costs to the end from one
+// backward Dijkstra. Only the k - found cheapest candidates are kept, and a
+// spur search stops once it cannot beat the worst of them. Fewer than `k`
+// paths are returned when the maze has fewer. expanded counts the cells
+// expanded by the searches that led to each path.
+std::vector<SolveResult> k_shortest_paths(const Grid& grid, int32_t start_cell, int32_t end_cell, int k);
+
+struct PathCount
+{
+    int64_t cost = -1;       // cost of a cheapest path, -1 when unreachable
+    uint64_t count = 0;      // number of distinct paths of that cost
+    bool saturated = false;  // count stopped at UINT64_MAX
+    int64_t expanded = 0;
+};
+
+// Counts the cheapest start-end paths without listing them: Dijkstra where
+// every cell adds its count to each neighbour it reaches at the same best
+// cost. Cells leave the queue in cost order and every cost is positive, so a
+// count is complete before it is passed on. Open areas have astronomically
+// many shortest paths, so the count saturates instead of wrapping.
+PathCount count_shortest_paths(const Grid& grid, int32_t start_cell, int32_t end_cell);
+
+#endif // PATH_ANALYSIS_HPP
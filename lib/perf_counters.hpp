@@ -0,0 +1,104 @@
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Process-wide counters for the generators and solvers, cheap enough to
+// leave on in the hot paths. Each thread adds to its own cache-line-sized
+// slot with relaxed atomics, so threads never contend; a snapshot sums the
+// slots. The counters only grow, so a reader works with the difference of
+// two snapshots. Allocations are counted by the operator new of the core
+// library, in the same slots.
+
+enum class PerfPhase
+{
+    Generate,
+    Solve,
+    Analyse,
+    Render
+};
+
+constexpr int PERF_PHASE_COUNT = 4;
+
+const char* perf_phase_name(PerfPhase phase);
+
+struct PerfSnapshot
+{
+    int64_t cells_visited = 0;     // cells carved, expanded or filled
+    int64_t frontier_peak = 0;     // largest stack, queue or heap since perf_reset_peak()
+    int64_t allocations = 0;
+    int64_t allocated_bytes = 0;
+    int64_t phase_ns[PERF_PHASE_COUNT] = {};
+    int64_t phase_runs[PERF_PHASE_COUNT] = {};
+};
+
+PerfSnapshot perf_snapshot();
+
+// Starts a new frontier high-water mark, say at the start of a run.
+void perf_reset_peak();
+
+// Per-run counting for one algorithm on one thread. visit() and frontier()
+// only touch locals; the totals reach the thread's slot every few thousand
+// visits and on destruction, so a live reader sees a run progress while it
+// costs the hot loop an increment and a compare.
+class PerfTally
+{
+public:
+    PerfTally() = default;
+    ~PerfTally() { flush(); }
+
+    PerfTally(const PerfTally&) = delete;
+    PerfTally& operator=(const PerfTally&) = delete;
+
+    void visit(int64_t cells = 1)
+    {
+        pending_ += cells;
+        if (pending_ >= FLUSH_EVERY) flush();
+    }
+
+    void frontier(size_t size)
+    {
+        if (static_cast<int64_t>(size) > peak_) peak_ = static_cast<int64_t>(size);
+    }
+
+    void flush();
+
+private:
+    static constexpr int64_t FLUSH_EVERY = 4096;
+
+    int64_t pending_ = 0;
+    int64_t peak_ = 0;
+    int64_t flushed_peak_ = 0;  // peak_ as of the last flush
+};
+
+// Adds the time from construction to destruction to a phase, and records it
+// as a Chrome trace event named `name` while tracing is on. `name` must
+// outlive the trace, which string literals and the algorithm lists do.
+class PerfTimer
+{
+public:
+    PerfTimer(PerfPhase phase, const char* name);
+    ~PerfTimer();
+
+    PerfTimer(const PerfTimer&) = delete;
+    PerfTimer& operator=(const PerfTimer&) = delete;
+
+private:
+    PerfPhase phase_;
+    const char* name_;
+    std::chrono::steady_clock::time_point begin_;
+};
+
+// Chrome trace recording (chrome://tracing, ui.perfetto.dev). While on,
+// every PerfTimer adds one complete event; the events stay in memory until
+// written. perf_write_chrome_trace() writes them as trace event JSON and
+// throws std::runtime_error if the file cannot be written.
+void perf_trace_start();
+void perf_trace_stop();
+bool perf_tracing();
+size_t perf_trace_size();
+void perf_write_chrome_trace(const std::string& path);
+
+#endif // PERF_COUNTERS_HPP
@@ -0,0 +1,180 @@
+#ifndef PRIORITY_QUEUES_HPP
+#define PRIORITY_QUEUES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Min-heap with a configurable branching factor. A 4-ary heap is shallower
+// than a binary one and keeps each sift inside fewer cache lines.
+template <class T, class Less = std::less<T>, int Arity = 4>
+class DaryHeap
+{
+public:
+    bool empty() const { return items_.empty(); }
+    size_t size() const { return items_.size(); }
+    void clear() { items_.clear(); }
+    void reserve(size_t capacity) { items_.reserve(capacity); }
+
+    const T& top() const { return items_.front(); }
+
+    void push(const T& item)
+    {
+        items_.push_back(item);
+        sift_up(items_.size() - 1);
+    }
+
+    void pop()
+    {
+        items_.front() = items_.back();
+        items_.pop_back();
+        if (!items_.empty()) sift_down(0);
+    }
+
+private:
+    void sift_up(size_t pos)
+    {
+        T item = items_[pos];
+        while (pos > 0) {
+            size_t parent = (pos - 1) / Arity;
+            if (!less_(item, items_[parent])) break;
+            items_[pos] = items_[parent];
+            pos = parent;
+        }
+        items_[pos] = item;
+    }
+
+    void sift_down(size_t pos)
+    {
+        T item = items_[pos];
+        size_t count = items_.size();
+        while (true) {
+            size_t first = pos * Arity + 1;
+            if (first >= count) break;
+            size_t last = first + Arity < count ? first + Arity : count;
+            size_t best = first;
+            for (size_t child = first + 1; child < last; ++child) {
+                if (less_(items_[child], items_[best])) best = child;
+            }
+            if (!less_(items_[best], item)) break;
+            items_[pos] = items_[best];
+            pos = best;
+        }
+        items_[pos] = item;
+    }
+
+    std::vector<T> items_;
+    Less less_;
+};
+
+// Monotone bucket queue (Dial's algorithm) for small integer keys. Every key
+// pushed must lie in [last popped key, last popped key + max_step], which holds
+// for Dijkstra when edge weights are at most max_step. Push and pop are O(1).
+template <class T>
+class BucketQueue
+{
+public:
+    explicit BucketQueue(int max_step = 1)
+        : buckets_(static_cast<size_t>(max_step) + 1)
+    {
+    }
+
+    bool empty() const { return count_ == 0; }
+    size_t size() const { return count_; }
+
+    void clear()
+    {
+        for (std::vector<T>& bucket : buckets_) bucket.clear();
+        current_ = 0;
+        count_ = 0;
+    }
+
+    void push(int32_t key, const T& value)
+    {
+        buckets_[static_cast<size_t>(key) % buckets_.size()].push_back(value);
+        ++count_;
+    }
+
+    // Removes an item with the smallest key; returns {key, item}.
+    std::pair<int32_t, T> pop()
+    {
+        std::vector<T>* bucket = &buckets_[static_cast<size_t>(current_) % buckets_.size()];
+        while (bucket->empty()) {
+            ++current_;
+            bucket = &buckets_[static_cast<size_t>(current_) % buckets_.size()];
+        }
+        T value = bucket->back();
+        bucket->pop_back();
+        --count_;
+        return {current_, value};
+    }
+
+private:
+    std::vector<std::vector<T>> buckets_;
+    int32_t current_ = 0;
+    size_t count_ = 0;
+};
+
+// Monotone radix heap (Ahuja, Mehlhorn, Orlin and Tarjan) for non-negative
+// int32 keys. Keys must not be smaller than the last popped key, which holds
+// for Dijkstra with non-negative weights. Bucket b > 0 holds the keys whose
+// highest bit differing from the last popped key is bit b - 1, so every key
+// moves down at most 32 times in its life: pop is amortised O(log C) for
+// keys spread over a range C, independent of the number of items.
+template <class T>
+class RadixHeap
+{
+public:
+    bool empty() const { return count_ == 0; }
+    size_t size() const { return count_; }
+
+    void clear()
+    {
+        for (std::vector<std::pair<int32_t, T>>& bucket : buckets_) bucket.clear();
+        last_ = 0;
+        count_ = 0;
+    }
+
+    void push(int32_t key, const T& value)
+    {
+        buckets_[bucket_of(key)].push_back({key, value});
+        ++count_;
+    }
+
+    // Removes an item with the smallest key; returns {key, item}.
+    std::pair<int32_t, T> pop()
+    {
+        if (buckets_[0].empty()) {
+            // The first non-empty bucket holds the new minimum. Every other
+            // key in it differs from that minimum below the bucket's bit, so
+            // they all land in lower buckets.
+            size_t b = 1;
+            while (buckets_[b].empty()) ++b;
+            std::vector<std::pair<int32_t, T>>& bucket = buckets_[b];
+            int32_t smallest = bucket.front().first;
+            for (const std::pair<int32_t, T>& item : bucket) smallest = item.first < smallest ? item.first : smallest;
+            last_ = smallest;
+            for (const std::pair<int32_t, T>& item : bucket) buckets_[bucket_of(item.first)].push_back(item);
+            bucket.clear();
+        }
+        std::pair<int32_t, T> item = buckets_[0].back();
+        buckets_[0].pop_back();
+        --count_;
+        return item;
+    }
+
+private:
+    size_t bucket_of(int32_t key) const
+    {
+        uint32_t diff = static_cast<uint32_t>(key) ^ static_cast<uint32_t>(last_);
+        return diff == 0 ? 0 : 32 - static_cast<size_t>(__builtin_clz(diff));
+    }
+
+    std::vector<std::pair<int32_t, T>> buckets_[33];
+    int32_t last_ = 0;
+    size_t count_ = 0;
+};
+
+#endif // PRIORITY_QUEUES_HPP
@@ -0,0 +1,139 @@
+#ifndef RNG_HPP
+#define RNG_HPP
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+// splitmix64 finaliser: a bijective mix of all 64 bits, used to turn seeds
+// and stream numbers into well-spread generator states.
+inline uint64_t mix64(uint64_t x)
+{
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+// xoshiro256** (Blackman and Vigna): 256 bits of state, period 2^256 - 1,
+// a handful of shifts and rotates per 64-bit output. Every seed, including
+// zero, is expanded through splitmix64, and the same seed and stream always
+// yield the same sequence on every platform.
+//
+// Rng satisfies UniformRandomBitGenerator, but the members below are
+// preferred over <random> distributions, whose output differs between
+// standard libraries.
+class Rng
+{
+public:
+    using result_type = uint64_t;
+
+    // Independent generators for the same seed are obtained by giving each
+    // its own `stream` number, e.g. one per tile or per thread.
+    explicit Rng(uint64_t seed = 0, uint64_t stream = 0)
+    {
+        uint64_t state = seed ^ mix64(stream);
+        for (uint64_t& word : s_) {
+            word = mix64(state);
+            state += 0x9E3779B97F4A7C15ull;
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<uint64_t>::max(); }
+    result_type operator()() { return next(); }
+
+    uint64_t next()
+    {
+        uint64_t result = rotl(s_[1] * 5, 7) * 9;
+        uint64_t t = s_[1] << 17;
+        s_[2] ^= s_[0];
+        s_[3] ^= s_[1];
+        s_[1] ^= s_[2];
+        s_[0] ^= s_[3];
+        s_[2] ^= t;
+        s_[3] = rotl(s_[3], 45);
+        return result;
+    }
+
+    // Unbiased integer in [0, bound) by Lemire's multiply-shift: one
+    // multiplication, and a division only in the rare rejection case.
+    // bound must be positive.
+    uint32_t below(uint32_t bound)
+    {
+        uint64_t product = (next() >> 32) * bound;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < bound) {
+            uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = (next() >> 32) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    // Fair coin, served from a buffered word so 64 flips cost one next().
+    bool coin()
+    {
+        if (bits_left_ == 0) {
+            bits_ = next();
+            bits_left_ = 64;
+        }
+        --bits_left_;
+        bool bit = bits_ & 1;
+        bits_ >>= 1;
+        return bit;
+    }
+
+    // Fisher-Yates with below(), so the order depends only on the seed.
+    template <class RandomIt>
+    void shuffle(RandomIt first, RandomIt last)
+    {
+        auto count = std::distance(first, last);
+        for (auto i = count - 1; i > 0; --i) {
+            auto j = below(static_cast<uint32_t>(i + 1));
+            using std::swap;
+            swap(first[i], first[j]);
+        }
+    }
+
+    // Advances by 2^128 outputs, the standard way to carve the period into
+    // non-overlapping subsequences.
+    void jump()
+    {
+        static constexpr uint64_t JUMP[4] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull,
+                                             0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+        uint64_t t[4] = {0, 0, 0, 0};
+        for (uint64_t word : JUMP) {
+            for (int bit = 0; bit < 64; ++bit) {
+                if (word & (uint64_t{1} << bit)) {
+                    for (int k = 0; k < 4; ++k) t[k] ^= s_[k];
+                }
+                next();
+            }
+        }
+        for (int k = 0; k < 4; ++k) s_[k] = t[k];
+        bits_left_ = 0;
+    }
+
+    // Returns a generator for the current position and jumps this one past
+    // it, so the two never overlap. Use it to hand each worker a stream.
+    Rng split()
+    {
+        Rng child = *this;
+        child.bits_left_ = 0;
+        jump();
+        return child;
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    uint64_t s_[4];
+    uint64_t bits_ = 0;
+    int bits_left_ = 0;
+};
+
+#endif // RNG_HPP
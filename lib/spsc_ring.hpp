@@ -0,0 +1,73 @@
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. The capacity is rounded up to a power of two. Each side keeps a
+// cached copy of the other side's index, so the shared cache lines are only
+// read again when the ring looks full (producer) or empty (consumer).
+template <class T>
+class SpscRing
+{
+public:
+    explicit SpscRing(size_t capacity)
+    {
+        size_t size = 2;
+        while (size < capacity) size *= 2;
+        slots_.reset(new T[size]);
+        mask_ = size - 1;
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // Producer side. Returns false when the ring is full.
+    bool try_push(const T& value)
+    {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) return false;
+        }
+        slots_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Passes up to max_items queued values to consume(value)
+    // in order and returns how many were taken.
+    template <class Consume>
+    size_t consume(Consume consume, size_t max_items)
+    {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (cached_tail_ == head) cached_tail_ = tail_.load(std::memory_order_acquire);
+        size_t count = cached_tail_ - head;
+        if (count > max_items) count = max_items;
+        for (size_t i = 0; i < count; ++i) consume(slots_[(head + i) & mask_]);
+        head_.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // Consumer side: discards everything currently queued.
+    void clear()
+    {
+        // The cached tail moves too: left behind, it would sit below head_
+        // and the next consume() would replay stale slots.
+        size_t tail = tail_.load(std::memory_order_acquire);
+        cached_tail_ = tail;
+        head_.store(tail, std::memory_order_release);
+    }
+
+private:
+    std::unique_ptr<T[]> slots_;
+    size_t mask_ = 0;
+
+    alignas(64) std::atomic<size_t> head_{0};   // next slot to read, written by the consumer
+    size_t cached_tail_ = 0;                     // consumer's last view of tail_
+    alignas(64) std::atomic<size_t> tail_{0};   // next slot to write, written by the producer
+    size_t cached_head_ = 0;                     // producer's last view of head_
+};
+
+#endif // SPSC_RING_HPP
@@ -0,0 +1,36 @@
+#ifndef TERRAIN_HPP
+#define TERRAIN_HPP
+
+#include "grid.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Generators for the cost layer of a Grid (see Grid::cost). Like the maze
+// generators they are pure functions of their seed, and they only touch the
+// costs, so terrain and maze can be combined freely.
+
+constexpr uint8_t MUD_COST = 4;
+constexpr uint8_t WATER_COST = 12;
+
+// Smooth fractal value noise mapped to costs 1..max_cost, with features
+// about an eighth of the grid's shorter side across.
+void fill_noise_costs(Grid& grid, uint64_t seed, int max_cost = 9);
+
+// Open ground at cost 1 with patches of mud (MUD_COST) that deepen into
+// ponds of water (WATER_COST), shaped by the same noise at a coarser scale.
+void fill_swamp_costs(Grid& grid, uint64_t seed);
+
+using TerrainFill = void (*)(Grid&, uint64_t);
+
+struct TerrainInfo
+{
+    const char* name;
+    TerrainFill fill;
+};
+
+const std::vector<TerrainInfo>& terrain_list();
+const TerrainInfo* find_terrain(const std::string& name);
+
+#endif // TERRAIN_HPP
@@ -0,0 +1,64 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads, each with its own task deque. A worker pops
+// its newest task first and, when its deque is empty, steals the oldest task
+// from another worker. Threads blocked in parallel_for run tasks too, so
+// nested parallel loops cannot deadlock the pool.
+class ThreadPool
+{
+public:
+    // thread_count <= 0 uses one worker per hardware thread.
+    explicit ThreadPool(int thread_count = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int thread_count() const { return static_cast<int>(threads_.size()); }
+
+    void submit(std::function<void()> task);
+
+    // Runs body(i) for every i in [begin, end), in chunks of `grain`
+    // iterations, and returns once all of them have finished.
+    void parallel_for(int64_t begin, int64_t end, const std::function<void(int64_t)>& body, int64_t grain = 1);
+
+    // Index of the calling worker in [0, thread_count()), or -1 when called
+    // from a thread outside the pool.
+    int current_worker() const;
+
+private:
+    struct TaskQueue
+    {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void worker_loop(int index);
+    bool try_run_task(int self);
+
+    std::vector<std::unique_ptr<TaskQueue>> queues_;
+    std::vector<std::thread> threads_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    std::atomic<int64_t> queued_{0};
+    std::atomic<uint32_t> next_queue_{0};
+    std::atomic<bool> stopping_{false};
+};
+
+// Process-wide pool shared by the parallel algorithms. The thread count can
+// be chosen before first use; afterwards the call has no effect.
+ThreadPool& default_thread_pool();
+void set_default_thread_count(int thread_count);
+
+#endif // THREAD_POOL_HPP
@@ -0,0 +1,104 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include "cell_events.hpp"
+#include "grid.hpp"
+#include "grid_snapshots.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Compact recording of an animated run: the sequence of cell changes an
+// algorithm published, so it can run at full speed once and be replayed at
+// any pace afterwards. Each event is delta-encoded as a varint of the
+// zigzagged distance to the previous event's cell (one byte for neighbours)
+// plus the new cell byte. Every keyframe_interval events the trace also
+// keeps a snapshot of the whole grid, which bounds the cost of a seek.
+//
+// By default the trace copies its keyframes from a grid of its own that it
+// keeps up to date. Given GridSnapshots attached on the algorithm's side
+// with the same interval, it adopts their snapshots instead and keeps no
+// grid, so recording costs O(1) per event on the recording thread. A
+// snapshot the writer replaced before it was taken is skipped, and seeks
+// near it replay from the keyframe before.
+class Trace : public CellEventSink
+{
+public:
+    // `initial` is the grid state before the first event. An interval of 0
+    // picks one keyframe per grid's worth of events, so snapshots take about
+    // as much memory as the events themselves.
+    explicit Trace(const Grid& initial, int64_t keyframe_interval = 0, GridSnapshots* snapshots = nullptr);
+
+    void publish(const CellEvent& event) override;
+
+    int64_t size() const { return event_count_; }
+    size_t encoded_bytes() const { return bytes_.size(); }
+    size_t keyframe_count() const { return keyframes_.size(); }
+    int64_t keyframe_interval() const { return interval_; }
+
+private:
+    friend class TracePlayer;
+
+    struct Keyframe
+    {
+        size_t offset;            // byte offset of the next event
+        int32_t previous_cell;
+        std::shared_ptr<const GridSnapshot> snapshot;
+    };
+
+    void add_keyframe();
+
+    Grid head_;  // empty when the keyframes come from snapshots_
+    GridSnapshots* snapshots_;
+    std::shared_ptr<const GridSnapshot> pending_;
+    int64_t interval_;
+    int64_t event_count_ = 0;
+    int32_t previous_cell_ = 0;
+    std::vector<uint8_t> bytes_;
+    std::vector<Keyframe> keyframes_;
+};
+
+// Replays a Trace into a Grid. The player only reads the trace, so the trace
+// may keep growing between calls, as long as both are used from one thread.
+class TracePlayer
+{
+public:
+    explicit TracePlayer(const Trace& trace) : trace_(&trace) {}
+
+    int64_t position() const { return position_; }
+    bool at_end() const { return position_ >= trace_->size(); }
+
+    // Applies up to `count` events to `grid` and calls changed(cell) for each
+    // one; cell is NO_CELL when every cell changed. Returns how many ran.
+    template <class Changed>
+    int64_t step(Grid& grid, int64_t count, Changed changed)
+    {
+        int64_t done = 0;
+        while (done < count && position_ < trace_->size()) {
+            CellEvent event = decode_next();
+            if (event.cell == NO_CELL) {
+                for (int32_t i = 0; i < grid.size(); ++i) grid[i] = event.state;
+            } else {
+                grid[event.cell] = event.state;
+            }
+            changed(event.cell);
+            ++done;
+        }
+        return done;
+    }
+
+    // Puts `grid` in the state after `target` events. Going backwards, or far
+    // forwards, restores the nearest earlier keyframe and replays from there,
+    // so no seek replays more than one keyframe interval.
+    void seek(Grid& grid, int64_t target);
+
+private:
+    CellEvent decode_next();
+
+    const Trace* trace_;
+    int64_t position_ = 0;
+    size_t offset_ = 0;
+    int32_t previous_cell_ = 0;
+};
+
+#endif // TRACE_HPP
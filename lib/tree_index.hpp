@@ -0,0 +1,70 @@
+#ifndef TREE_INDEX_HPP
+#define TREE_INDEX_HPP
+
+#include "grid.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Distance index over a perfect maze, whose passages form a spanning tree.
+// With the tree rooted at one cell, the only path between two cells climbs
+// from each to their lowest common ancestor, so a distance needs just the
+// two depths and the LCA.
+//
+// The LCA is the shallowest cell an Euler tour of the tree passes between
+// the first visits of the two cells, so it is a range-minimum query over the
+// tour. The tour is cut into blocks of 32 entries; a sparse table over block
+// minima answers whole blocks in O(1) and the two partial blocks at the ends
+// are scanned, which stays within a few cache lines. Memory is about 32
+// bytes per cell.
+class MazeTreeIndex
+{
+public:
+    // Roots the tree at `root`. Throws std::invalid_argument unless the
+    // passages connect every cell without forming a loop.
+    explicit MazeTreeIndex(const Grid& grid, int32_t root = 0);
+
+    int32_t size() const { return static_cast<int32_t>(parent_.size()); }
+    int32_t root() const { return root_; }
+    int32_t depth(int32_t cell) const { return depth_of(euler_[first_[cell]]); }
+    // NO_CELL for the root.
+    int32_t parent(int32_t cell) const { return cell == root_ ? NO_CELL : parent_[cell]; }
+
+    int32_t lca(int32_t a, int32_t b) const { return cell_of(tour_min(a, b)); }
+    int32_t distance(int32_t a, int32_t b) const
+    {
+        return depth(a) + depth(b) - 2 * depth_of(tour_min(a, b));
+    }
+
+    // The path a..b inclusive, in O(1) plus its length.
+    std::vector<int32_t> path(int32_t a, int32_t b) const;
+
+    // out[i] = distance(starts[i], ends[i]). Large batches are split across
+    // the default thread pool.
+    void distances(const int32_t* starts, const int32_t* ends, int32_t* out, size_t count) const;
+
+private:
+    static constexpr size_t BLOCK = 32;
+
+    // Tour entries pack the depth above the cell, so the smallest entry in a
+    // range is the shallowest cell and comparing entries compares depths.
+    static uint64_t entry(int32_t depth, int32_t cell)
+    {
+        return (static_cast<uint64_t>(depth) << 32) | static_cast<uint32_t>(cell);
+    }
+    static int32_t depth_of(uint64_t entry) { return static_cast<int32_t>(entry >> 32); }
+    static int32_t cell_of(uint64_t entry) { return static_cast<int32_t>(entry & 0xFFFFFFFFu); }
+
+    uint64_t tour_min(int32_t a, int32_t b) const;
+    uint64_t scan(size_t begin, size_t end) const;
+
+    std::vector<int32_t> parent_;     // the root is its own parent
+    std::vector<int32_t> first_;      // position of each cell's first tour entry
+    std::vector<uint64_t> euler_;     // 2N - 1 entries
+    std::vector<uint64_t> table_;     // level k, block i: min of blocks i..i + 2^k - 1
+    size_t blocks_ = 0;
+    int32_t root_ = 0;
+};
+
+#endif // TREE_INDEX_HPP
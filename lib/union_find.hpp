@@ -0,0 +1,107 @@
+#ifndef UNION_FIND_HPP
+#define UNION_FIND_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Single-threaded disjoint-set forest with full path compression and union
+// by rank (one byte of rank per element).
+class UnionFind
+{
+public:
+    explicit UnionFind(int32_t count)
+        : parent_(count), rank_(count, 0)
+    {
+        for (int32_t i = 0; i < count; ++i) parent_[i] = i;
+    }
+
+    int32_t find(int32_t x)
+    {
+        int32_t root = x;
+        while (parent_[root] != root) root = parent_[root];
+        while (parent_[x] != root) {
+            int32_t next = parent_[x];
+            parent_[x] = root;
+            x = next;
+        }
+        return root;
+    }
+
+    // Merges the sets of a and b; returns false if they were already joined.
+    bool unite(int32_t a, int32_t b)
+    {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (rank_[a] < rank_[b]) std::swap(a, b);
+        parent_[b] = a;
+        if (rank_[a] == rank_[b]) ++rank_[a];
+        return true;
+    }
+
+private:
+    std::vector<int32_t> parent_;
+    std::vector<uint8_t> rank_;
+};
+
+// Lock-free disjoint-set forest safe for concurrent find/unite calls. Roots
+// are always linked under the smaller index, so the final partition and the
+// representative of each set do not depend on thread interleaving.
+class ConcurrentUnionFind
+{
+public:
+    explicit ConcurrentUnionFind(int32_t count)
+        : parent_(new std::atomic<int32_t>[count]), count_(count)
+    {
+        for (int32_t i = 0; i < count; ++i) parent_[i].store(i, std::memory_order_relaxed);
+    }
+
+    int32_t size() const { return count_; }
+
+    // Path halving: each visited node is pointed at its grandparent.
+    int32_t find(int32_t x)
+    {
+        while (true) {
+            int32_t parent = parent_[x].load(std::memory_order_acquire);
+            if (parent == x) return x;
+            int32_t grandparent = parent_[parent].load(std::memory_order_acquire);
+            if (parent != grandparent) {
+                parent_[x].compare_exchange_weak(parent, grandparent, std::memory_order_release, std::memory_order_relaxed);
+            }
+            x = grandparent;
+        }
+    }
+
+    // Merges the sets of a and b; returns false if they were already joined.
+    bool unite(int32_t a, int32_t b)
+    {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return false;
+            if (a > b) std::swap(a, b);
+            int32_t expected = b;
+            if (parent_[b].compare_exchange_strong(expected, a, std::memory_order_acq_rel)) return true;
+        }
+    }
+
+    bool same(int32_t a, int32_t b)
+    {
+        while (true) {
+            a = find(a);
+            b = find(b);
+            if (a == b) return true;
+            // a is still a root, so the sets really are distinct right now.
+            if (parent_[a].load(std::memory_order_acquire) == a) return false;
+        }
+    }
+
+private:
+    std::unique_ptr<std::atomic<int32_t>[]> parent_;
+    int32_t count_;
+};
+
+#endif // UNION_FIND_HPP
@@ -0,0 +1,216 @@
+#include "bitboard.hpp"
+
+#include <algorithm>
+
+namespace {
+
+// Kogge-Stone occluded fills: spread `gen` along a row through the cells
+// whose bit in `pass` allows entry, in six shift steps for all 64 bits.
+// Eastwards, cell x + 1 can be entered from x when x is open east, so `pass`
+// is the east mask shifted up one; westwards it is the east mask itself.
+uint64_t fill_east(uint64_t gen, uint64_t pass)
+{
+    gen |= pass & (gen << 1);
+    pass &= pass << 1;
+    gen |= pass & (gen << 2);
+    pass &= pass << 2;
+    gen |= pass & (gen << 4);
+    pass &= pass << 4;
+    gen |= pass & (gen << 8);
+    pass &= pass << 8;
+    gen |= pass & (gen << 16);
+    pass &= pass << 16;
+    return gen | (pass & (gen << 32));
+}
+
+uint64_t fill_west(uint64_t gen, uint64_t pass)
+{
+    gen |= pass & (gen >> 1);
+    pass &= pass >> 1;
+    gen |= pass & (gen >> 2);
+    pass &= pass >> 2;
+    gen |= pass & (gen >> 4);
+    pass &= pass >> 4;
+    gen |= pass & (gen >> 8);
+    pass &= pass >> 8;
+    gen |= pass & (gen >> 16);
+    pass &= pass >> 16;
+    return gen | (pass & (gen >> 32));
+}
+
+constexpr uint64_t LOW_BIT = 1;
+constexpr uint64_t HIGH_BIT = uint64_t{1} << 63;
+
+} // namespace
+
+PassageBitboard::PassageBitboard(const Grid& grid)
+    : layout_(grid.layout()), width_(grid.width()), height_(grid.height()), words_per_row_((grid.width() + 63) / 64),
+      east_(static_cast<size_t>(grid.height()) * words_per_row_, 0),
+      south_(static_cast<size_t>(grid.height()) * words_per_row_, 0)
+{
+    // Each word is assembled in registers from its 64 cells without
+    // branches, which keeps the build well under the cost of one search.
+    // Rows of a tiled grid are gathered into a row buffer first.
+    const bool row_major = layout_.kind() == GridLayout::RowMajor;
+    std::vector<Cell> gathered(row_major ? 0 : static_cast<size_t>(width_));
+    const Cell* cells = grid.data();
+    for (int y = 0; y < height_; ++y) {
+        const Cell* row = cells + static_cast<size_t>(y) * width_;
+        if (!row_major) {
+            for (int x = 0; x < width_; ++x) gathered[x] = grid.at(x, y);
+            row = gathered.data();
+        }
+        for (int x0 = 0; x0 < width_; x0 += 64) {
+            int count = std::min(64, width_ - x0);
+            uint64_t east = 0;
+            uint64_t south = 0;
+            for (int bit = 0; bit < count; ++bit) {
+                uint64_t walls = row[x0 + bit].bits;
+                east |= ((~walls >> DIR_RIGHT) & 1) << bit;
+                south |= ((~walls >> DIR_BOTTOM) & 1) << bit;
+            }
+            east_[word_of(x0, y)] = east;
+            south_[word_of(x0, y)] = south;
+        }
+    }
+}
+
+std::vector<uint64_t> PassageBitboard::reachable(int32_t source) const
+{
+    std::vector<uint64_t> visited(word_count(), 0);
+    if (source == NO_CELL) return visited;
+    std::vector<uint64_t> pending(word_count(), 0);
+    std::vector<uint32_t> work;
+    source = board_cell(source);
+
+    auto emit = [&](size_t word, uint64_t bits) {
+        bits &= ~visited[word];
+        if (!bits) return;
+        if (!pending[word]) work.push_back(static_cast<uint32_t>(word));
+        pending[word] |= bits;
+    };
+
+    int x = source % width_;
+    emit(word_of(x, source / width_), uint64_t{1} << (x % 64));
+    const size_t stride = static_cast<size_t>(words_per_row_);
+    while (!work.empty()) {
+        size_t word = work.back();
+        work.pop_back();
+        uint64_t east = east_[word];
+        uint64_t closed = fill_west(fill_east(pending[word], east << 1), east);
+        pending[word] = 0;
+        uint64_t fresh = closed & ~visited[word];
+        if (!fresh) continue;
+        visited[word] |= fresh;
+
+        // Runs that cross a word boundary continue in the neighbouring word.
+        // Bit 63 of a row's last word is the last column or padding, both
+        // closed east, so runs never wrap onto the next row.
+        if (fresh & east & HIGH_BIT) emit(word + 1, LOW_BIT);
+        if ((fresh & LOW_BIT) && word > 0 && (east_[word - 1] & HIGH_BIT)) emit(word - 1, HIGH_BIT);
+        if (uint64_t down = fresh & south_[word]) emit(word + stride, down);
+        if (word >= stride) {
+            if (uint64_t up = fresh & south_[word - stride]) emit(word - stride, up);
+        }
+    }
+    return visited;
+}
+
+// Layered BFS shared by distances() and sweep(). Cells are marked visited
+// as soon as they are discovered, as in a scalar BFS, and the next level is
+// kept as (word, cells) pairs; a word reached from several sides appears once
+// per side. `discover(level, base, bits)` sees every newly reached batch,
+// where cell base + k is reached when bit k of `bits` is set.
+template <class Discover>
+BfsSummary PassageBitboard::search(int32_t source, Discover&& discover, const std::atomic<bool>* is_running) const
+{
+    BfsSummary result;
+    if (source == NO_CELL) return result;
+
+    struct FrontierWord
+    {
+        uint32_t word;
+        int32_t row;
+        uint64_t cells;
+    };
+    std::vector<uint64_t> visited(word_count(), 0);
+    std::vector<FrontierWord> active;
+    std::vector<FrontierWord> upcoming;
+    const size_t stride = static_cast<size_t>(words_per_row_);
+    int32_t level = 0;
+
+    auto emit = [&](size_t word, int32_t row, uint64_t bits) {
+        bits &= ~visited[word];
+        if (!bits) return;
+        visited[word] |= bits;
+        upcoming.push_back({static_cast<uint32_t>(word), row, bits});
+        result.reached += __builtin_popcountll(bits);
+        discover(level, row * width_ + static_cast<int32_t>(word - static_cast<size_t>(row) * stride) * 64, bits);
+    };
+
+    source = board_cell(source);
+    int x = source % width_;
+    emit(word_of(x, source / width_), source / width_, uint64_t{1} << (x % 64));
+    while (!upcoming.empty()) {
+        active.swap(upcoming);
+        upcoming.clear();
+        if (is_running && !is_running->load(std::memory_order_relaxed)) break;
+        result.max_distance = level++;
+        for (const FrontierWord& frontier : active) {
+            size_t word = frontier.word;
+            int32_t row = frontier.row;
+            uint64_t cells = frontier.cells;
+            uint64_t east = east_[word];
+            uint64_t leaving_east = cells & east;
+            emit(word, row, (leaving_east << 1) | ((cells >> 1) & east));
+            if (leaving_east & HIGH_BIT) emit(word + 1, row, LOW_BIT);
+            if ((cells & LOW_BIT) && word > 0 && (east_[word - 1] & HIGH_BIT)) emit(word - 1, row, HIGH_BIT);
+            if (uint64_t down = cells & south_[word]) emit(word + stride, row + 1, down);
+            if (row > 0) {
+                if (uint64_t up = cells & south_[word - stride]) emit(word - stride, row - 1, up);
+            }
+        }
+    }
+
+    // Any cell of the last level is a farthest one.
+    const FrontierWord& last = active.back();
+    result.farthest = grid_cell(last.row * width_
+                                + static_cast<int32_t>(last.word - static_cast<size_t>(last.row) * stride) * 64
+                                + __builtin_ctzll(last.cells));
+    return result;
+}
+
+DistanceMap PassageBitboard::distances(int32_t source) const
+{
+    DistanceMap result;
+    result.distance.assign(static_cast<size_t>(width_) * height_, -1);
+    int32_t* distance = result.distance.data();
+    if (layout_.kind() == GridLayout::RowMajor) {
+        static_cast<BfsSummary&>(result) = search(source, [distance](int32_t level, int32_t base, uint64_t bits) {
+            do {
+                distance[base + __builtin_ctzll(bits)] = level;
+                bits &= bits - 1;
+            } while (bits);
+        });
+    } else {
+        static_cast<BfsSummary&>(result) = search(source, [&](int32_t level, int32_t base, uint64_t bits) {
+            do {
+                distance[grid_cell(base + __builtin_ctzll(bits))] = level;
+                bits &= bits - 1;
+            } while (bits);
+        });
+    }
+    return result;
+}
+
+BfsSummary PassageBitboard::sweep(int32_t source, int32_t target, const std::atomic<bool>* is_running) const
+{
+    int32_t target_distance = -1;
+    target = board_cell(target);
+    BfsSummary result = search(source, [&](int32_t level, int32_t base, uint64_t bits) {
+        uint32_t offset = static_cast<uint32_t>(target - base);
+        if (offset < 64 && (bits >> offset) & 1) target_distance = level;
+    }, is_running);
+    result.target_distance = target_distance;
+    return result;
+}
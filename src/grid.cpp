@@ -0,0 +1,86 @@
+#include "grid.hpp"
+#include "cell_events.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+Grid::Grid(int width, int height, GridLayout layout)
+    : width_(width), height_(height)
+{
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("grid dimensions must be positive");
+    }
+    if (static_cast<int64_t>(width) * height > std::numeric_limits<int32_t>::max()) {
+        throw std::invalid_argument("grid has more cells than int32 indices can address");
+    }
+    layout_ = CellLayout(width, height, layout);
+    cells_.resize(static_cast<size_t>(width) * height);
+}
+
+CellLayout::CellLayout(int width, int height, GridLayout kind)
+    : width_(width), tiled_(kind == GridLayout::Tiled)
+{
+    if (!tiled_) {
+        offsets_[DIR_TOP] = -width;
+        offsets_[DIR_RIGHT] = 1;
+        offsets_[DIR_BOTTOM] = width;
+        offsets_[DIR_LEFT] = -1;
+        return;
+    }
+    if (width % TILE_SIDE != 0 || height % TILE_SIDE != 0) {
+        throw std::invalid_argument("tiled layout needs a width and height that are multiples of 64");
+    }
+    tiles_x_ = width / TILE_SIDE;
+    offsets_[DIR_TOP] = tiles_x_ * TILE_CELLS;
+    offsets_[DIR_RIGHT] = TILE_CELLS;
+    offsets_[DIR_BOTTOM] = tiles_x_ * TILE_CELLS;
+    offsets_[DIR_LEFT] = TILE_CELLS;
+}
+
+void Grid::reset()
+{
+    std::fill(cells_.begin(), cells_.end(), Cell{});
+    if (events_) events_->publish({NO_CELL, Cell{}});
+}
+
+void Grid::publish_event(int32_t i) const
+{
+    events_->publish({i, cells_[i]});
+}
+
+void Grid::set_cost(int32_t i, uint8_t cost)
+{
+    if (cost == 0) cost = 1;
+    if (costs_.empty()) {
+        if (cost == 1) return;
+        costs_.assign(cells_.size(), 1);
+    }
+    costs_[i] = cost;
+    min_cost_ = std::min<int>(min_cost_, cost);
+    max_cost_ = std::max<int>(max_cost_, cost);
+}
+
+void Grid::set_costs(std::vector<uint8_t> costs)
+{
+    if (costs.size() != cells_.size()) {
+        throw std::invalid_argument("cost layer must have one entry per cell");
+    }
+    if (costs.empty()) return;
+    auto range = std::minmax_element(costs.begin(), costs.end());
+    if (*range.first == 0) {
+        throw std::invalid_argument("cell costs must be at least 1");
+    }
+    min_cost_ = *range.first;
+    max_cost_ = *range.second;
+    costs_ = std::move(costs);
+}
+
+void Grid::clear_costs()
+{
+    costs_.clear();
+    costs_.shrink_to_fit();
+    min_cost_ = 1;
+    max_cost_ = 1;
+}
@@ -0,0 +1,29 @@
+#include "grid_snapshots.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+void GridSnapshots::attach(const Grid& initial, CellEventSink& downstream, int64_t interval)
+{
+    if (interval <= 0) throw std::invalid_argument("snapshot interval must be positive");
+    downstream_ = &downstream;
+    back_.assign(initial.data(), initial.data() + initial.size());
+    interval_ = interval;
+    events_ = 0;
+    std::atomic_store(&front_, std::shared_ptr<const GridSnapshot>());
+}
+
+void GridSnapshots::publish(const CellEvent& event)
+{
+    downstream_->publish(event);
+    if (event.cell == NO_CELL) std::fill(back_.begin(), back_.end(), event.state);
+    else back_[event.cell] = event.state;
+    if (++events_ % interval_ == 0) {
+        std::atomic_store(&front_, std::shared_ptr<const GridSnapshot>(std::make_shared<GridSnapshot>(GridSnapshot{events_, back_})));
+    }
+}
+
+std::shared_ptr<const GridSnapshot> GridSnapshots::take()
+{
+    return std::atomic_exchange(&front_, std::shared_ptr<const GridSnapshot>());
+}
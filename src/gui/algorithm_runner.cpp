@@ -0,0 +1,126 @@
+#include "algorithm_runner.hpp"
+#include "perf_counters.hpp"
+
+#include <iostream>
+
+namespace {
+
+// Upper bound on the changes recorded per frame, so a fast algorithm cannot
+// stall the window; the ring's back-pressure holds it until the next frame.
+constexpr int64_t MAX_RECORD_PER_FRAME = 1 << 22;
+
+// Turns the Visited/Frontier/Path marks an animated generator leaves behind
+// back into empty cells, publishing each change. Stops early once nobody is
+// listening any more.
+void clear_leftover_marks(Grid& grid, const CellEventChannel& channel)
+{
+    for (int32_t i = 0; i < grid.size(); ++i) {
+        if ((i & 0xFFFF) == 0 && channel.closed()) return;
+        CellType type = grid[i].type();
+        if (type == CellType::Visited || type == CellType::Frontier || type == CellType::Path) {
+            grid[i].set_type(CellType::Empty);
+            grid.publish(i);
+        }
+    }
+}
+
+} // namespace
+
+void AlgorithmRunner::start(Grid& grid, GridRenderer& renderer, std::vector<Task> tasks, bool clear_marks)
+{
+    stop(grid, renderer);
+    work_ = grid;
+    channel_.open();
+    trace_ = std::make_unique<Trace>(grid, snapshot_interval_, &snapshots_);
+    player_ = std::make_unique<TracePlayer>(*trace_);
+    paused_ = false;
+    // The HUD's frontier peak is per run.
+    perf_reset_peak();
+    // The token's flag is the algorithm's is_running: cancel() clears it to
+    // stop the algorithm, and the algorithm clears it when it is done.
+    int64_t interval = trace_->keyframe_interval();
+    cancelled_ = false;
+    job_ = jobs_.submit([this, tasks = std::move(tasks), interval, clear_marks](const CancelToken& token) {
+        snapshots_.attach(work_, channel_, interval);
+        work_.set_event_sink(&snapshots_);
+        for (size_t i = 0; i < tasks.size(); ++i) {
+            if (i > 0) {
+                // Re-arm the flag the previous task cleared, then check for a
+                // cancel() that may have come before; cancel() sets
+                // cancelled_ before clearing the flag, so one of the two
+                // stores is seen.
+                token.running()->store(true);
+                if (cancelled_) return;
+            }
+            tasks[i](work_, token.running());
+        }
+        if (clear_marks) clear_leftover_marks(work_, channel_);
+    });
+}
+
+void AlgorithmRunner::record()
+{
+    if (!busy()) return;
+
+    // Read before draining: once the job has finished it publishes nothing
+    // more, so an empty drain afterwards means everything is recorded.
+    bool finished = job_.ready();
+    int64_t recorded = 0;
+    size_t drained;
+    do {
+        drained = channel_.drain([&](const CellEvent& event) { trace_->publish(event); }, 1 << 16);
+        recorded += static_cast<int64_t>(drained);
+    } while (drained > 0 && recorded < MAX_RECORD_PER_FRAME);
+    if (!finished || drained > 0) return;
+
+    try {
+        job_.get();
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << "\n";
+    }
+}
+
+void AlgorithmRunner::update(Grid& grid, GridRenderer& renderer)
+{
+    record();
+    if (!player_ || paused_) return;
+
+    bool redraw_all = false;
+    player_->step(grid, speed_, [&](int32_t cell) {
+        if (cell == NO_CELL) redraw_all = true;
+        else if (!redraw_all) renderer.update_cell(cell, grid[cell]);
+    });
+    if (redraw_all) renderer.update(grid);
+}
+
+void AlgorithmRunner::seek(Grid& grid, GridRenderer& renderer, int64_t position)
+{
+    if (!player_) return;
+    player_->seek(grid, position);
+    renderer.update(grid);
+}
+
+bool AlgorithmRunner::finish(Grid& grid, GridRenderer& renderer)
+{
+    record();
+    if (busy()) return false;
+    if (!player_) return true;
+    seek(grid, renderer, length());
+    player_.reset();
+    trace_.reset();
+    return true;
+}
+
+void AlgorithmRunner::cancel()
+{
+    if (job_.valid()) {
+        cancelled_ = true;
+        job_.cancel();
+        channel_.close();
+        // A job cancelled while still queued never runs; get() reports that.
+        job_.wait();
+        job_ = Job<void>();
+    }
+    player_.reset();
+    trace_.reset();
+}
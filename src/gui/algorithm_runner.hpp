@@ -0,0 +1,99 @@
+#ifndef ALGORITHM_RUNNER_HPP
+#define ALGORITHM_RUNNER_HPP
+
+#include "cell_events.hpp"
+#include "grid.hpp"
+#include "grid_renderer.hpp"
+#include "grid_snapshots.hpp"
+#include "job_scheduler.hpp"
+#include "trace.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Runs one generator or solver at a time as a job and plays it back. The
+// algorithm works at full speed on a private copy of the grid and publishes
+// its changes through a CellEventChannel; the GUI thread records them into
+// a Trace and replays that into the displayed grid at the chosen speed, so
+// playback can be paused, stepped and scrubbed while the algorithm is still
+// running. Everything proportional to the grid's size happens in the job:
+// the trace's keyframes are snapshots double-buffered by GridSnapshots, and
+// a generator's leftover marks are cleared there too, so a frame only ever
+// costs the events it records and plays.
+class AlgorithmRunner
+{
+public:
+    using Task = std::function<void(Grid&, std::atomic<bool>*)>;
+
+    // A snapshot is published every snapshot_interval events; 0 picks one
+    // per grid's worth of events, as Trace does.
+    explicit AlgorithmRunner(JobScheduler& jobs, int64_t snapshot_interval = 0)
+        : jobs_(jobs), snapshot_interval_(snapshot_interval) {}
+    ~AlgorithmRunner() { cancel(); }
+
+    // True while the algorithm's job is still producing changes.
+    bool busy() const { return job_.valid(); }
+
+    // Stops the previous run as stop() does, then starts `task` on a copy
+    // of `grid`. With clear_marks, Visited/Frontier/Path marks are removed
+    // at the end of the recording, as a generator's animation leaves them.
+    void start(Grid& grid, GridRenderer& renderer, Task task, bool clear_marks)
+    {
+        start(grid, renderer, std::vector<Task>{std::move(task)}, clear_marks);
+    }
+
+    // Runs `tasks` one after the other in a single job on the same copy, as
+    // one recording, e.g. a generator and then a solver on its maze.
+    void start(Grid& grid, GridRenderer& renderer, std::vector<Task> tasks, bool clear_marks);
+
+    // Once per frame: records what the algorithm published since the last
+    // call, then plays speed() events unless paused.
+    void update(Grid& grid, GridRenderer& renderer);
+
+    // Playback controls. Seeking clamps to the part recorded so far.
+    void seek(Grid& grid, GridRenderer& renderer, int64_t position);
+    void step(Grid& grid, GridRenderer& renderer, int64_t count) { seek(grid, renderer, position() + count); }
+    void set_paused(bool paused) { paused_ = paused; }
+    bool paused() const { return paused_; }
+    void set_speed(int64_t events_per_frame) { speed_ = events_per_frame; }
+    int64_t speed() const { return speed_; }
+    int64_t position() const { return player_ ? player_->position() : 0; }
+    int64_t length() const { return trace_ ? trace_->size() : 0; }
+
+    // Shows the end state of the current run and drops its trace, before
+    // the grid is edited directly. Never waits: while the algorithm is still
+    // running it does nothing and returns false, and the edit should be
+    // skipped.
+    bool finish(Grid& grid, GridRenderer& renderer);
+
+    // Stops the algorithm, waits for its job and drops the recording. The
+    // algorithms poll their flag, so the wait is short.
+    void cancel();
+
+    // Cancels a run still in progress, or fast-forwards a finished one with
+    // finish(), before the grid is edited or a new run starts from it.
+    void stop(Grid& grid, GridRenderer& renderer)
+    {
+        if (!finish(grid, renderer)) cancel();
+    }
+
+private:
+    void record();
+
+    JobScheduler& jobs_;
+    int64_t snapshot_interval_;
+    Grid work_;
+    CellEventChannel channel_{1 << 16};
+    GridSnapshots snapshots_;
+    Job<void> job_;
+    // Set by cancel(). The job reads it between tasks, since an algorithm
+    // clears the token's flag whenever it ends, cancelled or not.
+    std::atomic<bool> cancelled_{false};
+    std::unique_ptr<Trace> trace_;
+    std::unique_ptr<TracePlayer> player_;
+    bool paused_ = false;
+    int64_t speed_ = 64;
+};
+
+#endif // ALGORITHM_RUNNER_HPP
@@ -0,0 +1,55 @@
+#include "camera.hpp"
+
+#include <algorithm>
+
+namespace {
+
+// Closest zoom: a cell as large as the window is tall; furthest: the whole
+// grid in a few pixels.
+constexpr float MIN_PIXELS_PER_CELL = 1.0f / 4096.0f;
+
+} // namespace
+
+Camera::Camera(int grid_width, int grid_height, sf::Vector2u window_size)
+    : grid_width_(grid_width), grid_height_(grid_height),
+      window_size_(static_cast<float>(window_size.x), static_cast<float>(window_size.y))
+{
+    fit();
+}
+
+void Camera::fit()
+{
+    pixels_per_cell_ = std::min(window_size_.x / grid_width_, window_size_.y / grid_height_);
+    center_ = sf::Vector2f(grid_width_ / 2.0f, grid_height_ / 2.0f);
+    apply();
+}
+
+void Camera::zoom_at(sf::Vector2i pixel, float factor)
+{
+    sf::Vector2f anchor = to_world(pixel);
+    float zoomed = std::clamp(pixels_per_cell_ * factor, MIN_PIXELS_PER_CELL, window_size_.y);
+    // Keep `anchor` under the cursor: it sits (pixel - half window) pixels
+    // from the centre before and after the zoom.
+    sf::Vector2f offset(pixel.x - window_size_.x / 2.0f, pixel.y - window_size_.y / 2.0f);
+    center_ = sf::Vector2f(anchor.x - offset.x / zoomed, anchor.y - offset.y / zoomed);
+    pixels_per_cell_ = zoomed;
+    apply();
+}
+
+void Camera::pan(sf::Vector2i delta)
+{
+    center_ = sf::Vector2f(center_.x - delta.x / pixels_per_cell_, center_.y - delta.y / pixels_per_cell_);
+    apply();
+}
+
+sf::Vector2f Camera::to_world(sf::Vector2i pixel) const
+{
+    return sf::Vector2f(center_.x + (pixel.x - window_size_.x / 2.0f) / pixels_per_cell_,
+                        center_.y + (pixel.y - window_size_.y / 2.0f) / pixels_per_cell_);
+}
+
+void Camera::apply()
+{
+    view_.setCenter(center_);
+    view_.setSize(window_size_.x / pixels_per_cell_, window_size_.y / pixels_per_cell_);
+}
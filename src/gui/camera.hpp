@@ -0,0 +1,37 @@
+#ifndef CAMERA_HPP
+#define CAMERA_HPP
+
+#include <SFML/Graphics.hpp>
+
+// Zoom and pan over the grid. World coordinates are in cells: cell (x, y)
+// covers [x, x + 1) x [y, y + 1).
+class Camera
+{
+public:
+    Camera(int grid_width, int grid_height, sf::Vector2u window_size);
+
+    // Shows the whole grid, centred, as large as it fits.
+    void fit();
+
+    // Scales by `factor` (> 1 zooms in) keeping the cell under `pixel` fixed.
+    void zoom_at(sf::Vector2i pixel, float factor);
+
+    // Moves the view so the content follows a mouse drag of `delta` pixels.
+    void pan(sf::Vector2i delta);
+
+    const sf::View& view() const { return view_; }
+    float pixels_per_cell() const { return pixels_per_cell_; }
+    sf::Vector2f to_world(sf::Vector2i pixel) const;
+
+private:
+    void apply();
+
+    int grid_width_;
+    int grid_height_;
+    sf::Vector2f window_size_;
+    sf::Vector2f center_;
+    float pixels_per_cell_ = 1.0f;
+    sf::View view_;
+};
+
+#endif // CAMERA_HPP
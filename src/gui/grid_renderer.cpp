@@ -0,0 +1,250 @@
+#include "grid_renderer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int VERTICES_PER_QUAD = 4;
+constexpr int WALL_VERTICES_PER_CELL = 4 * VERTICES_PER_QUAD;
+// Below this many pixels per cell walls are not worth drawing one by one.
+constexpr float DETAIL_MIN_PIXELS_PER_CELL = 3.0f;
+constexpr int TILE_SIZE = 512;
+// Re-uploads of already shown tiles per frame; the rest wait a frame or two
+// rather than stalling a fully zoomed-out view of a busy grid.
+constexpr int MAX_TILE_REFRESHES_PER_FRAME = 8;
+
+sf::Color cell_color(CellType type)
+{
+    switch (type)
+    {
+        case CellType::Start: return sf::Color::Green;
+        case CellType::End: return sf::Color::Red;
+        case CellType::Visited: return sf::Color(0, 100, 100);
+        case CellType::Path: return sf::Color(128, 0, 0);
+        case CellType::Frontier: return sf::Color(0, 0, 128);
+        default: return sf::Color::Black;
+    }
+}
+
+// Heat map of the cost layer: cost 1 stays black, higher costs run through
+// dark red and orange to yellow at the grid's highest cost.
+sf::Color heat_color(int cost, int max_cost)
+{
+    float t = static_cast<float>(cost - 1) / static_cast<float>(std::max(1, max_cost - 1));
+    float red = 60.0f + 195.0f * std::min(1.0f, 2.0f * t);
+    float green = 200.0f * std::max(0.0f, 2.0f * t - 1.0f);
+    return sf::Color(static_cast<sf::Uint8>(red), static_cast<sf::Uint8>(green), 0);
+}
+
+// Marked cells keep their marker colour; empty ones show their cost.
+sf::Color fill_color(Cell cell, int cost, int max_cost)
+{
+    if (cell.type() != CellType::Empty || cost <= 1) return cell_color(cell.type());
+    return heat_color(cost, max_cost);
+}
+
+// One texel per cell when zoomed out. Walls are too small to see, so empty
+// cells are shaded by how many passages they have: corridors and junctions
+// come out lighter than dead ends, and an uncarved grid stays black. Costly
+// cells show their heat colour instead.
+sf::Color lod_color(Cell cell, int cost, int max_cost)
+{
+    if (cell.type() != CellType::Empty || cost > 1) return fill_color(cell, cost, max_cost);
+    int open = 4 - __builtin_popcount(cell.walls());
+    uint8_t level = static_cast<uint8_t>(open == 0 ? 0 : 70 + 45 * open);
+    return sf::Color(level, level, level);
+}
+
+void set_quad(sf::Vertex* quad, float left, float top, float width, float height, sf::Color color)
+{
+    quad[0].position = sf::Vector2f(left, top);
+    quad[1].position = sf::Vector2f(left + width, top);
+    quad[2].position = sf::Vector2f(left + width, top + height);
+    quad[3].position = sf::Vector2f(left, top + height);
+    for (int i = 0; i < VERTICES_PER_QUAD; ++i) quad[i].color = color;
+}
+
+} // namespace
+
+GridRenderer::GridRenderer(const Grid& grid)
+{
+    rebuild(grid);
+}
+
+void GridRenderer::rebuild(const Grid& grid)
+{
+    layout_ = grid.layout();
+    width_ = grid.width();
+    height_ = grid.height();
+    window_valid_ = false;
+    tiles_x_ = (width_ + TILE_SIZE - 1) / TILE_SIZE;
+    tiles_y_ = (height_ + TILE_SIZE - 1) / TILE_SIZE;
+    tiles_.clear();
+    tiles_.resize(static_cast<size_t>(tiles_x_) * tiles_y_);
+    visible_tiles_.clear();
+    copy_costs(grid);
+}
+
+void GridRenderer::copy_costs(const Grid& grid)
+{
+    if (grid.weighted()) costs_.assign(grid.costs(), grid.costs() + grid.size());
+    else costs_.clear();
+    max_cost_ = grid.max_cost();
+}
+
+void GridRenderer::update(const Grid& grid)
+{
+    copy_costs(grid);
+    window_valid_ = false;
+    for (std::unique_ptr<Tile>& tile : tiles_) {
+        if (tile) tile->stale = true;
+    }
+}
+
+void GridRenderer::update_cell(int32_t cell, Cell state)
+{
+    int x = layout_.x_of(cell);
+    int y = layout_.y_of(cell);
+    if (window_valid_ && x >= window_.x0 && x < window_.x1 && y >= window_.y0 && y < window_.y1) {
+        write_cell(x, y, state);
+    }
+    Tile* tile = tiles_[static_cast<size_t>(y / TILE_SIZE) * tiles_x_ + x / TILE_SIZE].get();
+    if (tile && !tile->stale) {
+        tile->image.setPixel(x % TILE_SIZE, y % TILE_SIZE, lod_color(state, cost_at(x, y), max_cost_));
+        tile->dirty = true;
+    }
+}
+
+GridRenderer::CellRange GridRenderer::visible_range(const Camera& camera) const
+{
+    const sf::View& view = camera.view();
+    sf::Vector2f center = view.getCenter();
+    sf::Vector2f size = view.getSize();
+    CellRange range;
+    range.x0 = std::clamp(static_cast<int>(std::floor(center.x - size.x / 2)), 0, width_);
+    range.y0 = std::clamp(static_cast<int>(std::floor(center.y - size.y / 2)), 0, height_);
+    range.x1 = std::clamp(static_cast<int>(std::ceil(center.x + size.x / 2)), 0, width_);
+    range.y1 = std::clamp(static_cast<int>(std::ceil(center.y + size.y / 2)), 0, height_);
+    return range;
+}
+
+void GridRenderer::prepare(const Grid& grid, const Camera& camera)
+{
+    CellRange visible = visible_range(camera);
+    detail_ = camera.pixels_per_cell() >= DETAIL_MIN_PIXELS_PER_CELL;
+    if (!detail_) {
+        prepare_tiles(grid, visible);
+        return;
+    }
+
+    // Walls stay one pixel wide at any zoom, so zooming rebuilds the window.
+    float thickness = 1.0f / camera.pixels_per_cell();
+    if (window_valid_ && thickness == wall_thickness_ && window_.contains(visible)) return;
+    wall_thickness_ = thickness;
+
+    // Keep half a screen of margin on every side so panning rarely rebuilds.
+    int margin_x = (visible.x1 - visible.x0) / 2 + 1;
+    int margin_y = (visible.y1 - visible.y0) / 2 + 1;
+    CellRange range;
+    range.x0 = std::max(0, visible.x0 - margin_x);
+    range.y0 = std::max(0, visible.y0 - margin_y);
+    range.x1 = std::min(width_, visible.x1 + margin_x);
+    range.y1 = std::min(height_, visible.y1 + margin_y);
+    build_window(grid, range);
+}
+
+void GridRenderer::build_window(const Grid& grid, const CellRange& range)
+{
+    window_ = range;
+    window_valid_ = true;
+    size_t cells = static_cast<size_t>(range.x1 - range.x0) * (range.y1 - range.y0);
+    fills_.setPrimitiveType(sf::Quads);
+    fills_.resize(cells * VERTICES_PER_QUAD);
+    walls_.setPrimitiveType(sf::Quads);
+    walls_.resize(cells * WALL_VERTICES_PER_CELL);
+    for (int y = range.y0; y < range.y1; ++y) {
+        for (int x = range.x0; x < range.x1; ++x) write_cell(x, y, grid.at(x, y));
+    }
+}
+
+void GridRenderer::write_cell(int x, int y, Cell state)
+{
+    size_t slot = static_cast<size_t>(y - window_.y0) * (window_.x1 - window_.x0) + (x - window_.x0);
+    float left = static_cast<float>(x);
+    float top = static_cast<float>(y);
+    set_quad(&fills_[slot * VERTICES_PER_QUAD], left, top, 1.0f, 1.0f, fill_color(state, cost_at(x, y), max_cost_));
+
+    // A missing wall keeps its quad but collapses it to zero size, so the
+    // vertex layout never changes.
+    sf::Vertex* quads = &walls_[slot * WALL_VERTICES_PER_CELL];
+    float thick = wall_thickness_;
+    float far = 1.0f - thick;
+    for (int dir = 0; dir < 4; ++dir) {
+        float extent = state.has_wall(dir) ? 1.0f : 0.0f;
+        sf::Vertex* quad = quads + dir * VERTICES_PER_QUAD;
+        switch (dir)
+        {
+            case DIR_TOP: set_quad(quad, left, top, extent, thick * extent, sf::Color::White); break;
+            case DIR_RIGHT: set_quad(quad, left + far, top, thick * extent, extent, sf::Color::White); break;
+            case DIR_BOTTOM: set_quad(quad, left, top + far, extent, thick * extent, sf::Color::White); break;
+            default: set_quad(quad, left, top, thick * extent, extent, sf::Color::White); break;
+        }
+    }
+}
+
+void GridRenderer::prepare_tiles(const Grid& grid, const CellRange& range)
+{
+    visible_tiles_.clear();
+    if (range.x1 <= range.x0 || range.y1 <= range.y0) return;
+    int refreshes = 0;
+    for (int ty = range.y0 / TILE_SIZE; ty <= (range.y1 - 1) / TILE_SIZE; ++ty) {
+        for (int tx = range.x0 / TILE_SIZE; tx <= (range.x1 - 1) / TILE_SIZE; ++tx) {
+            int index = ty * tiles_x_ + tx;
+            std::unique_ptr<Tile>& tile = tiles_[index];
+            int tile_width = std::min(TILE_SIZE, width_ - tx * TILE_SIZE);
+            int tile_height = std::min(TILE_SIZE, height_ - ty * TILE_SIZE);
+            if (!tile) {
+                tile = std::make_unique<Tile>();
+                tile->image.create(tile_width, tile_height);
+                tile->texture.create(tile_width, tile_height);
+                tile->texture.setSmooth(true);
+            }
+            bool shown = tile->uploaded;
+            if (tile->stale && (!shown || refreshes < MAX_TILE_REFRESHES_PER_FRAME)) {
+                for (int y = 0; y < tile_height; ++y) {
+                    for (int x = 0; x < tile_width; ++x) {
+                        int cell_x = tx * TILE_SIZE + x;
+                        int cell_y = ty * TILE_SIZE + y;
+                        tile->image.setPixel(x, y, lod_color(grid.at(cell_x, cell_y), cost_at(cell_x, cell_y), max_cost_));
+                    }
+                }
+                tile->stale = false;
+                tile->dirty = true;
+            }
+            if (tile->dirty && (!shown || refreshes < MAX_TILE_REFRESHES_PER_FRAME)) {
+                tile->texture.update(tile->image);
+                tile->texture.generateMipmap();
+                tile->dirty = false;
+                tile->uploaded = true;
+                if (shown) ++refreshes;
+            }
+            visible_tiles_.push_back(index);
+        }
+    }
+}
+
+void GridRenderer::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    if (detail_) {
+        target.draw(fills_, states);
+        target.draw(walls_, states);
+        return;
+    }
+    for (int index : visible_tiles_) {
+        sf::Sprite sprite(tiles_[index]->texture);
+        sprite.setPosition(static_cast<float>((index % tiles_x_) * TILE_SIZE),
+                           static_cast<float>((index / tiles_x_) * TILE_SIZE));
+        target.draw(sprite, states);
+    }
+}
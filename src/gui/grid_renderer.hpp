@@ -0,0 +1,96 @@
+#ifndef GRID_RENDERER_HPP
+#define GRID_RENDERER_HPP
+
+#include <SFML/Graphics.hpp>
+#include "camera.hpp"
+#include "grid.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Draws a Grid through a Camera in one of two modes.
+//
+// Detail mode, when cells are a few pixels or larger: two persistent vertex
+// arrays (cell fills and walls) cover only the cells around the visible
+// range, so a frame is two draw calls. Each cell in that window owns a fixed
+// block of vertices that update_cell() rewrites in place; the window is
+// rebuilt only when the camera leaves it or zooms.
+//
+// Level-of-detail mode, when zoomed out: the grid is split into tiles whose
+// textures hold one texel per cell and are mipmapped, so the GPU averages
+// cells down to pixels. Tiles are built lazily when first seen, updated
+// texel by texel, and only tiles in view are uploaded and drawn.
+//
+// Both modes draw the grid's cost layer as a heat map under empty cells. The
+// costs are copied on rebuild() and update(), so call update() after
+// changing them.
+class GridRenderer : public sf::Drawable
+{
+public:
+    explicit GridRenderer(const Grid& grid);
+
+    // Starts over for a grid of a different size.
+    void rebuild(const Grid& grid);
+
+    // Everything may have changed; geometry and tiles are refreshed lazily.
+    void update(const Grid& grid);
+
+    // Redraws one cell with a known new state, for event-driven updates.
+    void update_cell(int32_t cell, Cell state);
+
+    // Once per frame, before drawing: picks the mode for the camera's zoom
+    // and brings what is in view up to date with `grid`.
+    void prepare(const Grid& grid, const Camera& camera);
+
+protected:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+    struct CellRange
+    {
+        int x0 = 0, y0 = 0, x1 = 0, y1 = 0;  // half-open
+
+        bool contains(const CellRange& other) const
+        {
+            return other.x0 >= x0 && other.y0 >= y0 && other.x1 <= x1 && other.y1 <= y1;
+        }
+    };
+
+    struct Tile
+    {
+        sf::Image image;
+        sf::Texture texture;
+        bool stale = true;   // image must be rebuilt from the grid
+        bool dirty = false;  // image changed since the last upload
+        bool uploaded = false;
+    };
+
+    void copy_costs(const Grid& grid);
+    int cost_at(int x, int y) const { return costs_.empty() ? 1 : costs_[layout_.index(x, y)]; }
+    CellRange visible_range(const Camera& camera) const;
+    void build_window(const Grid& grid, const CellRange& range);
+    void write_cell(int x, int y, Cell state);
+    void prepare_tiles(const Grid& grid, const CellRange& range);
+
+    CellLayout layout_;  // the grid's, to place the cells of update_cell()
+    int width_ = 0;
+    int height_ = 0;
+    bool detail_ = true;
+    std::vector<uint8_t> costs_;  // empty while the grid is unweighted
+    int max_cost_ = 1;
+
+    // Detail mode.
+    CellRange window_;
+    bool window_valid_ = false;
+    float wall_thickness_ = 0.0f;
+    sf::VertexArray fills_;
+    sf::VertexArray walls_;
+
+    // Level-of-detail mode.
+    int tiles_x_ = 0;
+    int tiles_y_ = 0;
+    std::vector<std::unique_ptr<Tile>> tiles_;
+    std::vector<int> visible_tiles_;
+};
+
+#endif // GRID_RENDERER_HPP
@@ -0,0 +1,526 @@
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <string>
+
+#include "algorithm_runner.hpp"
+#include "bitboard.hpp"
+#include "camera.hpp"
+#include "grid_renderer.hpp"
+#include "incremental_solver.hpp"
+#include "job_scheduler.hpp"
+#include "maze_creators.hpp"
+#include "maze_file.hpp"
+#include "maze_solvers.hpp"
+#include "maze_stats.hpp"
+#include "maze_utils.hpp"
+#include "perf_counters.hpp"
+#include "perf_hud.hpp"
+#include "rng.hpp"
+#include "terrain.hpp"
+#include "text_overlay.hpp"
+
+#define WINDOW_WIDTH 1280
+#define WINDOW_HEIGHT 960
+#define SAVE_FILE "maze.maze"
+#define TRACE_FILE "maze_trace.json"
+
+int main(int argc, char* argv[]) {
+    int grid_width = GRID_WIDTH;
+    int grid_height = GRID_HEIGHT;
+    if (argc >= 3) {
+        grid_width = std::max(1, std::atoi(argv[1]));
+        grid_height = std::max(1, std::atoi(argv[2]));
+    }
+
+    // A single argument names a saved .maze file to open.
+    Grid grid;
+    try {
+        grid = argc == 2 ? load_maze(argv[1]) : Grid(grid_width, grid_height);
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << "\n";
+        return 1;
+    }
+
+    sf::RenderWindow window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "SFML MazeVisualizer");
+    int32_t start_cell = NO_CELL;
+    int32_t end_cell = NO_CELL;
+
+    // Generators and solvers, statistics, saving and loading all run as
+    // jobs, each on its own copy of the maze, so none of them holds up the
+    // window; finished results are swapped in from this thread.
+    JobScheduler jobs(2);
+    // Keys that edit the grid directly are ignored while an algorithm is
+    // still running: runner.finish() says so without waiting for it.
+    AlgorithmRunner runner(jobs);
+    size_t creator_index = 0;
+
+    // Each generated maze gets a fresh seed, shown in the title and stored
+    // by W, so any maze can be reproduced with maze_cli --seed.
+    Rng seeds(std::random_device{}());
+    uint64_t maze_seed = 0;
+    auto next_seed = [&](const char* generator) {
+        maze_seed = seeds.next();
+        window.setTitle(std::string("SFML MazeVisualizer - ") + generator + " seed " + std::to_string(maze_seed));
+        return maze_seed;
+    };
+
+    // Mouse wheel zooms around the cursor, dragging with the left button
+    // pans, and 0 fits the whole grid back into the window.
+    Camera camera(grid.width(), grid.height(), window.getSize());
+    GridRenderer renderer(grid);
+    bool dragging = false;
+    sf::Vector2i drag_from;
+    window.setFramerateLimit(60);
+
+    // Live path (I): an incremental solver keeps the shortest path drawn and
+    // repairs it after every S/E move or wall toggle (T), re-expanding only
+    // the cells whose distance changed.
+    IncrementalSolver live_solver(grid);
+    bool live_path = false;
+    std::vector<int32_t> shown_path;
+
+    auto clear_shown_path = [&]() {
+        for (int32_t cell : shown_path) {
+            if (grid[cell].type() == CellType::Path) {
+                grid[cell].set_type(CellType::Empty);
+                renderer.update_cell(cell, grid[cell]);
+            }
+        }
+        shown_path.clear();
+    };
+
+    auto refresh_live_path = [&]() {
+        clear_shown_path();
+        shown_path = live_solver.solve(start_cell, end_cell).path;
+        for (int32_t cell : shown_path) {
+            if (grid[cell].type() == CellType::Empty) {
+                grid[cell].set_type(CellType::Path);
+                renderer.update_cell(cell, grid[cell]);
+            }
+        }
+    };
+
+    // Anything that rewrites the maze wholesale ends live mode.
+    auto stop_live_path = [&]() {
+        if (!live_path) return;
+        live_path = false;
+        clear_shown_path();
+        live_solver.reset();
+    };
+
+    // Maze statistics (M) in the top-left corner. They are recomputed after
+    // any key press, once the algorithm and its playback are done; a key
+    // press cancels an analysis still in flight, which stops at its next
+    // row or sweep level and frees its worker.
+    TextOverlay stats_overlay;
+    bool show_stats = false;
+    bool stats_stale = true;
+    Job<MazeStats> stats_job;
+
+    // W and L write and read maze.maze as jobs; a second press while one
+    // is pending is ignored.
+    Job<void> save_job;
+    Job<Grid> load_job;
+
+    // Performance HUD (H) in the top-right corner. O starts recording a
+    // Chrome trace of the generate/solve/draw phases and, pressed again,
+    // writes it to maze_trace.json for chrome://tracing or Perfetto.
+    PerfHud hud;
+    bool show_hud = false;
+    sf::Clock frame_clock;
+
+    while (window.isOpen()) {
+        // Set by edits made directly on the grid from this thread; changes
+        // made by the algorithm thread arrive through the runner instead.
+        bool grid_edited = false;
+        sf::Event event;
+        while (window.pollEvent(event))
+        {
+            if (event.type == sf::Event::Closed)
+            {
+                runner.cancel();
+                window.close();
+            }
+            if (event.type == sf::Event::MouseWheelScrolled && event.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel)
+            {
+                camera.zoom_at(sf::Vector2i(event.mouseWheelScroll.x, event.mouseWheelScroll.y),
+                               std::pow(1.25f, event.mouseWheelScroll.delta));
+            }
+            if (event.type == sf::Event::MouseButtonPressed && event.mouseButton.button == sf::Mouse::Left)
+            {
+                dragging = true;
+                drag_from = sf::Vector2i(event.mouseButton.x, event.mouseButton.y);
+            }
+            if (event.type == sf::Event::MouseButtonReleased && event.mouseButton.button == sf::Mouse::Left)
+            {
+                dragging = false;
+            }
+            if (event.type == sf::Event::MouseMoved && dragging)
+            {
+                sf::Vector2i to(event.mouseMove.x, event.mouseMove.y);
+                camera.pan(sf::Vector2i(to.x - drag_from.x, to.y - drag_from.y));
+                drag_from = to;
+            }
+            if (event.type == sf::Event::KeyReleased)
+            {
+                sf::Vector2f mouse_world = camera.to_world(sf::Mouse::getPosition(window));
+                int gridX = static_cast<int>(std::floor(mouse_world.x));
+                int gridY = static_cast<int>(std::floor(mouse_world.y));
+
+                stats_stale = true;
+                if (stats_job.valid())
+                {
+                    stats_job.cancel();
+                    stats_job = Job<MazeStats>();
+                }
+
+                if(event.key.code == sf::Keyboard::Num0)
+                {
+                    camera.fit();
+                }
+
+                if(event.key.code == sf::Keyboard::M)
+                {
+                    show_stats = !show_stats;
+                    if (!show_stats) stats_overlay.clear();
+                }
+
+                if(event.key.code == sf::Keyboard::H)
+                {
+                    show_hud = !show_hud;
+                    if (!show_hud) hud.clear();
+                }
+
+                if(event.key.code == sf::Keyboard::O)
+                {
+                    if (!perf_tracing()) {
+                        perf_trace_start();
+                    } else {
+                        perf_trace_stop();
+                        try {
+                            perf_write_chrome_trace(TRACE_FILE);
+                            std::cout << "Wrote " << perf_trace_size() << " trace events to " << TRACE_FILE << "\n";
+                        } catch (const std::exception& error) {
+                            std::cerr << error.what() << "\n";
+                        }
+                    }
+                }
+
+                if(event.key.code == sf::Keyboard::D)
+                {
+                    stop_live_path();
+                    runner.start(grid, renderer, std::bind(create_dfs_maze, std::placeholders::_1, next_seed("dfs"), start_cell, end_cell, std::placeholders::_2), true);
+                }
+
+                if(event.key.code == sf::Keyboard::B)
+                {
+                    stop_live_path();
+                    runner.start(grid, renderer, std::bind(create_bfs_maze, std::placeholders::_1, next_seed("bfs"), start_cell, end_cell, std::placeholders::_2), true);
+                }
+
+                if(event.key.code == sf::Keyboard::P)
+                {
+                    stop_live_path();
+                    runner.start(grid, renderer, std::bind(static_cast<MazeCreator>(create_parallel_maze), std::placeholders::_1, next_seed("parallel"), start_cell, end_cell, std::placeholders::_2), true);
+                }
+
+                // G cycles through every registered generator and runs the next one.
+                if(event.key.code == sf::Keyboard::G)
+                {
+                    const MazeCreatorInfo& creator = maze_creator_list()[creator_index];
+                    creator_index = (creator_index + 1) % maze_creator_list().size();
+                    stop_live_path();
+                    runner.start(grid, renderer, std::bind(creator.create, std::placeholders::_1, next_seed(creator.name), start_cell, end_cell, std::placeholders::_2), true);
+                }
+
+                // W writes the maze to maze.maze, L reads it back if the size matches.
+                if(event.key.code == sf::Keyboard::W && !save_job.valid() && runner.finish(grid, renderer))
+                {
+                    save_job = jobs.submit([snapshot = grid, seed = maze_seed](const CancelToken&) {
+                        save_maze(snapshot, SAVE_FILE, seed, "gui");
+                    });
+                }
+
+                if(event.key.code == sf::Keyboard::L && !load_job.valid())
+                {
+                    load_job = jobs.submit([](const CancelToken&) { return load_maze(SAVE_FILE); });
+                }
+
+                if(event.key.code == sf::Keyboard::R && runner.finish(grid, renderer))
+                {
+                    stop_live_path();
+                    cells_reset(grid);
+                    grid_edited = true;
+                    start_cell = NO_CELL;
+                    end_cell = NO_CELL;
+                }
+
+                // Terrain: N fills the cost layer with noise, V with mud and
+                // water, C clears it. Walls and markers are left alone.
+                if((event.key.code == sf::Keyboard::N || event.key.code == sf::Keyboard::V || event.key.code == sf::Keyboard::C)
+                   && runner.finish(grid, renderer))
+                {
+                    if (event.key.code == sf::Keyboard::N) fill_noise_costs(grid, seeds.next());
+                    else if (event.key.code == sf::Keyboard::V) fill_swamp_costs(grid, seeds.next());
+                    else grid.clear_costs();
+                    grid_edited = true;
+                    if (live_path) live_solver.reset();
+                }
+
+                // Y braids the maze: half of its dead ends are opened into
+                // loops, so there is more than one way through.
+                if(event.key.code == sf::Keyboard::Y && runner.finish(grid, renderer))
+                {
+                    braid_maze(grid, seeds.next(), 0.5);
+                    grid_edited = true;
+                    if (live_path) live_solver.reset();
+                }
+
+                MazeSolver solver = nullptr;
+                switch (event.key.code)
+                {
+                    case sf::Keyboard::K: solver = dijkstra_solve; break;
+                    case sf::Keyboard::U: solver = dial_solve; break;
+                    case sf::Keyboard::A: solver = astar_solve; break;
+                    case sf::Keyboard::F: solver = bfs_solve; break;
+                    case sf::Keyboard::J: solver = bidirectional_solve; break;
+                    case sf::Keyboard::Z: solver = dead_end_fill_solve; break;
+                    default: break;
+                }
+
+                // A solver key cancels a run in progress like a generator key.
+                // Without a maze it generates one first, in the same job.
+                if(solver)
+                {
+                    runner.stop(grid, renderer);
+                    stop_live_path();
+                    if (start_cell == NO_CELL)
+                    {
+                        start_cell = grid.index(0, 0);
+                        grid[start_cell].set_type(CellType::Start);
+                        renderer.update_cell(start_cell, grid[start_cell]);
+                    }
+                    if (end_cell == NO_CELL)
+                    {
+                        end_cell = grid.index(grid.width() - 1, grid.height() - 1);
+                        grid[end_cell].set_type(CellType::End);
+                        renderer.update_cell(end_cell, grid[end_cell]);
+                    }
+
+                    std::vector<AlgorithmRunner::Task> tasks;
+                    if (!is_maze_generated(grid)) {
+                        tasks.push_back(std::bind(create_bfs_maze, std::placeholders::_1, next_seed("bfs"), start_cell, end_cell, std::placeholders::_2));
+                    }
+                    tasks.push_back(std::bind(solver, std::placeholders::_1, start_cell, end_cell, std::placeholders::_2));
+                    runner.start(grid, renderer, std::move(tasks), false);
+                }
+
+                // Playback: Space pauses, arrows step one change, Home/End and
+                // PageUp/PageDown seek, - and = halve or double the speed.
+                switch (event.key.code)
+                {
+                    case sf::Keyboard::Space: runner.set_paused(!runner.paused()); break;
+                    case sf::Keyboard::Right: runner.set_paused(true); runner.step(grid, renderer, 1); break;
+                    case sf::Keyboard::Left: runner.set_paused(true); runner.step(grid, renderer, -1); break;
+                    case sf::Keyboard::Home: runner.seek(grid, renderer, 0); break;
+                    case sf::Keyboard::End: runner.seek(grid, renderer, runner.length()); break;
+                    case sf::Keyboard::PageUp: runner.step(grid, renderer, -std::max<int64_t>(1, runner.length() / 10)); break;
+                    case sf::Keyboard::PageDown: runner.step(grid, renderer, std::max<int64_t>(1, runner.length() / 10)); break;
+                    case sf::Keyboard::Hyphen: runner.set_speed(std::max<int64_t>(1, runner.speed() / 2)); break;
+                    case sf::Keyboard::Equal: runner.set_speed(std::min<int64_t>(1 << 24, runner.speed() * 2)); break;
+                    default: break;
+                }
+
+                if(event.key.code == sf::Keyboard::S)
+                {
+                    if (grid.in_bounds(gridX, gridY) && runner.finish(grid, renderer))
+                    {
+                        int32_t index = grid.index(gridX, gridY);
+                        if (grid[index].type() != CellType::Start)
+                        {
+                            if (start_cell != NO_CELL) {
+                                grid[start_cell].set_type(CellType::Empty);
+                            }
+                            grid[index].set_type(CellType::Start);
+                            start_cell = index;
+                        }
+                        else
+                        {
+                            grid[index].set_type(CellType::Empty);
+                            start_cell = NO_CELL;
+                        }
+                        grid_edited = true;
+                    }
+                }
+                if(event.key.code == sf::Keyboard::E)
+                {
+                    if (grid.in_bounds(gridX, gridY) && runner.finish(grid, renderer))
+                    {
+                        int32_t index = grid.index(gridX, gridY);
+                        if (grid[index].type() != CellType::End)
+                        {
+                            if (end_cell != NO_CELL) {
+                                grid[end_cell].set_type(CellType::Empty);
+                            }
+                            grid[index].set_type(CellType::End);
+                            end_cell = index;
+                        }
+                        else
+                        {
+                            grid[index].set_type(CellType::Empty);
+                            end_cell = NO_CELL;
+                        }
+                        grid_edited = true;
+                    }
+                }
+
+                // X moves the end marker to the cell farthest from the start.
+                if(event.key.code == sf::Keyboard::X && start_cell != NO_CELL && runner.finish(grid, renderer))
+                {
+                    int32_t farthest = PassageBitboard(grid).distances(start_cell).farthest;
+                    if (farthest != start_cell && farthest != end_cell)
+                    {
+                        if (end_cell != NO_CELL) {
+                            grid[end_cell].set_type(CellType::Empty);
+                        }
+                        grid[farthest].set_type(CellType::End);
+                        end_cell = farthest;
+                        grid_edited = true;
+                    }
+                }
+
+                // T toggles the wall of the hovered cell nearest the cursor.
+                if(event.key.code == sf::Keyboard::T)
+                {
+                    if (grid.in_bounds(gridX, gridY) && runner.finish(grid, renderer))
+                    {
+                        float fx = mouse_world.x - gridX;
+                        float fy = mouse_world.y - gridY;
+                        float edge_distance[4] = {fy, 1.0f - fx, 1.0f - fy, fx};
+                        int dir = static_cast<int>(std::min_element(edge_distance, edge_distance + 4) - edge_distance);
+                        int32_t index = grid.index(gridX, gridY);
+                        int32_t other = grid.neighbour(index, dir);
+                        if (other != NO_CELL)
+                        {
+                            if (grid[index].has_wall(dir)) grid.remove_wall(index, dir);
+                            else grid.add_wall(index, dir);
+                            live_solver.wall_changed(index, dir);
+                            renderer.update_cell(index, grid[index]);
+                            renderer.update_cell(other, grid[other]);
+                        }
+                    }
+                }
+
+                if(event.key.code == sf::Keyboard::I && runner.finish(grid, renderer))
+                {
+                    if (live_path)
+                    {
+                        stop_live_path();
+                    }
+                    else
+                    {
+                        // Drop the marks of an earlier animated run first.
+                        for (int32_t i = 0; i < grid.size(); ++i) {
+                            CellType type = grid[i].type();
+                            if (type == CellType::Visited || type == CellType::Frontier || type == CellType::Path) {
+                                grid[i].set_type(CellType::Empty);
+                            }
+                        }
+                        grid_edited = true;
+                        live_path = true;
+                        live_solver.reset();
+                    }
+                }
+
+                if (live_path && (event.key.code == sf::Keyboard::S || event.key.code == sf::Keyboard::E
+                                  || event.key.code == sf::Keyboard::X || event.key.code == sf::Keyboard::T
+                                  || event.key.code == sf::Keyboard::I || event.key.code == sf::Keyboard::N
+                                  || event.key.code == sf::Keyboard::V || event.key.code == sf::Keyboard::C
+                                  || event.key.code == sf::Keyboard::Y))
+                {
+                    refresh_live_path();
+                }
+            }
+                
+        }
+
+        if (save_job.ready())
+        {
+            try {
+                save_job.get();
+                std::cout << "Saved " << SAVE_FILE << "\n";
+            } catch (const std::exception& error) {
+                std::cerr << error.what() << "\n";
+            }
+        }
+
+        // A loaded maze replaces the displayed one here, between frames.
+        if (load_job.ready())
+        {
+            try {
+                Grid loaded = load_job.get();
+                if (loaded.width() == grid.width() && loaded.height() == grid.height()) {
+                    runner.cancel();
+                    stop_live_path();
+                    // Files hold only the maze; the terrain stays.
+                    if (grid.weighted()) loaded.set_costs(std::vector<uint8_t>(grid.costs(), grid.costs() + grid.size()));
+                    grid = std::move(loaded);
+                    grid_edited = true;
+                    start_cell = NO_CELL;
+                    end_cell = NO_CELL;
+                    stats_stale = true;
+                } else {
+                    std::cerr << SAVE_FILE << " holds a " << loaded.width() << "x" << loaded.height()
+                              << " maze; restart with it as the argument to open it\n";
+                }
+            } catch (const std::exception& error) {
+                std::cerr << error.what() << "\n";
+            }
+        }
+
+        runner.update(grid, renderer);
+        if (show_stats && stats_stale && !stats_job.valid() && !runner.busy() && runner.position() == runner.length())
+        {
+            stats_job = jobs.submit([snapshot = grid, start = start_cell, end = end_cell](const CancelToken& token) {
+                return analyse_maze(snapshot, start, end, token.running());
+            });
+            stats_stale = false;
+        }
+        if (stats_job.ready())
+        {
+            try {
+                if (show_stats) stats_overlay.set_lines(maze_stats_lines(stats_job.get()));
+            } catch (const std::exception& error) {
+                std::cerr << error.what() << "\n";
+            }
+            stats_job = Job<MazeStats>();
+        }
+
+        window.clear(sf::Color::Cyan);
+        sf::Clock draw_clock;
+        {
+            PerfTimer timer(PerfPhase::Render, "draw");
+            if (grid_edited) renderer.update(grid);
+            renderer.prepare(grid, camera);
+            window.setView(camera.view());
+            window.draw(renderer);
+        }
+        double draw_seconds = draw_clock.getElapsedTime().asSeconds();
+        double frame_seconds = frame_clock.restart().asSeconds();
+        window.draw(stats_overlay);
+        if (show_hud)
+        {
+            hud.frame(frame_seconds, draw_seconds, runner.position(), runner.length(), runner.busy());
+            window.draw(hud);
+        }
+        window.display();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "perf_hud.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr double WINDOW_SECONDS = 0.25;
+
+// Rates with a K or M suffix, so the panel keeps its width.
+std::string rate(double per_second)
+{
+    char buffer[32];
+    if (per_second >= 1e6) std::snprintf(buffer, sizeof buffer, "%.2fM", per_second / 1e6);
+    else if (per_second >= 1e3) std::snprintf(buffer, sizeof buffer, "%.1fK", per_second / 1e3);
+    else std::snprintf(buffer, sizeof buffer, "%.0f", per_second);
+    return buffer;
+}
+
+} // namespace
+
+PerfHud::PerfHud()
+    : overlay_(3.0f, true), last_(perf_snapshot())
+{
+}
+
+void PerfHud::frame(double frame_seconds, double draw_seconds, int64_t events, int64_t length, bool running)
+{
+    ++frames_;
+    frame_total_ += frame_seconds;
+    frame_worst_ = std::max(frame_worst_, frame_seconds);
+    draw_total_ += draw_seconds;
+    double elapsed = window_clock_.getElapsedTime().asSeconds();
+    if (elapsed < WINDOW_SECONDS) return;
+
+    PerfSnapshot now = perf_snapshot();
+    double steps = static_cast<double>(now.cells_visited - last_.cells_visited) / elapsed;
+    double allocations = static_cast<double>(now.allocations - last_.allocations) / elapsed;
+    char buffer[96];
+    std::vector<std::string> lines;
+    std::snprintf(buffer, sizeof buffer, "fps %.1f", frames_ / elapsed);
+    lines.push_back(buffer);
+    std::snprintf(buffer, sizeof buffer, "frame %.2f ms  max %.2f", 1e3 * frame_total_ / frames_, 1e3 * frame_worst_);
+    lines.push_back(buffer);
+    std::snprintf(buffer, sizeof buffer, "draw %.2f ms", 1e3 * draw_total_ / frames_);
+    lines.push_back(buffer);
+    lines.push_back("steps/s " + rate(steps) + (running ? "  running" : ""));
+    std::snprintf(buffer, sizeof buffer, "frontier peak %lld", static_cast<long long>(now.frontier_peak));
+    lines.push_back(buffer);
+    lines.push_back("allocs/s " + rate(allocations));
+    std::snprintf(buffer, sizeof buffer, "playback %lld/%lld", static_cast<long long>(events), static_cast<long long>(length));
+    lines.push_back(buffer);
+    if (perf_tracing()) {
+        std::snprintf(buffer, sizeof buffer, "trace %zu events", perf_trace_size());
+        lines.push_back(buffer);
+    }
+    overlay_.set_lines(lines);
+
+    last_ = now;
+    frames_ = 0;
+    frame_total_ = 0.0;
+    frame_worst_ = 0.0;
+    draw_total_ = 0.0;
+    window_clock_.restart();
+}
+
+void PerfHud::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    target.draw(overlay_, states);
+}
@@ -0,0 +1,37 @@
+#ifndef PERF_HUD_HPP
+#define PERF_HUD_HPP
+
+#include <SFML/Graphics.hpp>
+#include "perf_counters.hpp"
+#include "text_overlay.hpp"
+#include <cstdint>
+
+// Live performance panel in the top-right corner: frame rate, frame and
+// draw times, and what the algorithm thread is doing, read from the core's
+// counters. Frames are averaged over a short window and the text is rebuilt
+// once per window, so the panel itself costs next to nothing.
+class PerfHud : public sf::Drawable
+{
+public:
+    PerfHud();
+
+    // Once per frame with the time of the whole frame and of drawing the
+    // grid. `events` and `length` are the playback position and trace size.
+    void frame(double frame_seconds, double draw_seconds, int64_t events, int64_t length, bool running);
+
+    void clear() { overlay_.clear(); }
+
+protected:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+    TextOverlay overlay_;
+    sf::Clock window_clock_;
+    int frames_ = 0;
+    double frame_total_ = 0.0;
+    double frame_worst_ = 0.0;
+    double draw_total_ = 0.0;
+    PerfSnapshot last_;
+};
+
+#endif // PERF_HUD_HPP
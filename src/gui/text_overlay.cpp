@@ -0,0 +1,115 @@
+#include "text_overlay.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+
+namespace {
+
+constexpr int GLYPH_WIDTH = 3;
+constexpr int GLYPH_HEIGHT = 5;
+constexpr int ADVANCE = GLYPH_WIDTH + 1;
+constexpr int LINE_HEIGHT = GLYPH_HEIGHT + 2;
+constexpr float MARGIN = 8.0f;
+constexpr int PADDING = 2;  // in font pixels
+
+// Five rows of three bits, top row in the high bits and the leftmost pixel
+// of each row in its highest bit.
+constexpr uint16_t rows(int r0, int r1, int r2, int r3, int r4)
+{
+    return static_cast<uint16_t>((r0 << 12) | (r1 << 9) | (r2 << 6) | (r3 << 3) | r4);
+}
+
+uint16_t glyph(char c)
+{
+    static const uint16_t LETTERS[26] = {
+        rows(07, 05, 07, 05, 05), rows(06, 05, 06, 05, 06), rows(07, 04, 04, 04, 07), rows(06, 05, 05, 05, 06),
+        rows(07, 04, 06, 04, 07), rows(07, 04, 06, 04, 04), rows(07, 04, 05, 05, 07), rows(05, 05, 07, 05, 05),
+        rows(07, 02, 02, 02, 07), rows(01, 01, 01, 05, 07), rows(05, 05, 06, 05, 05), rows(04, 04, 04, 04, 07),
+        rows(05, 07, 07, 05, 05), rows(06, 05, 05, 05, 05), rows(07, 05, 05, 05, 07), rows(07, 05, 07, 04, 04),
+        rows(07, 05, 05, 07, 01), rows(06, 05, 06, 05, 05), rows(07, 04, 07, 01, 07), rows(07, 02, 02, 02, 02),
+        rows(05, 05, 05, 05, 07), rows(05, 05, 05, 05, 02), rows(05, 05, 07, 07, 05), rows(05, 05, 02, 05, 05),
+        rows(05, 05, 02, 02, 02), rows(07, 01, 02, 04, 07),
+    };
+    static const uint16_t DIGITS[10] = {
+        rows(07, 05, 05, 05, 07), rows(02, 06, 02, 02, 07), rows(07, 01, 07, 04, 07), rows(07, 01, 07, 01, 07),
+        rows(05, 05, 07, 01, 01), rows(07, 04, 07, 01, 07), rows(07, 04, 07, 05, 07), rows(07, 01, 01, 01, 01),
+        rows(07, 05, 07, 05, 07), rows(07, 05, 07, 01, 07),
+    };
+
+    unsigned char u = static_cast<unsigned char>(c);
+    if (std::isalpha(u)) return LETTERS[std::toupper(u) - 'A'];
+    if (std::isdigit(u)) return DIGITS[u - '0'];
+    switch (c)
+    {
+        case '.': return rows(0, 0, 0, 0, 02);
+        case ',': return rows(0, 0, 0, 02, 04);
+        case ':': return rows(0, 02, 0, 02, 0);
+        case '-': return rows(0, 0, 07, 0, 0);
+        case '+': return rows(0, 02, 07, 02, 0);
+        case '=': return rows(0, 07, 0, 07, 0);
+        case '%': return rows(05, 01, 02, 04, 05);
+        case '/': return rows(01, 01, 02, 04, 04);
+        case '(': return rows(01, 02, 02, 02, 01);
+        case ')': return rows(04, 02, 02, 02, 04);
+        default: return 0;
+    }
+}
+
+void append_quad(sf::VertexArray& vertices, float left, float top, float width, float height, sf::Color color)
+{
+    vertices.append(sf::Vertex(sf::Vector2f(left, top), color));
+    vertices.append(sf::Vertex(sf::Vector2f(left + width, top), color));
+    vertices.append(sf::Vertex(sf::Vector2f(left + width, top + height), color));
+    vertices.append(sf::Vertex(sf::Vector2f(left, top + height), color));
+}
+
+} // namespace
+
+TextOverlay::TextOverlay(float scale, bool right_aligned)
+    : scale_(scale), right_aligned_(right_aligned), vertices_(sf::Quads)
+{
+}
+
+void TextOverlay::set_lines(const std::vector<std::string>& lines)
+{
+    vertices_.clear();
+    if (lines.empty()) return;
+
+    size_t columns = 0;
+    for (const std::string& line : lines) columns = std::max(columns, line.size());
+    float panel_width = (static_cast<float>(columns * ADVANCE) - 1 + 2 * PADDING) * scale_;
+    panel_width_ = panel_width;
+    float panel_height = (static_cast<float>(lines.size() * LINE_HEIGHT) - 2 + 2 * PADDING) * scale_;
+    append_quad(vertices_, MARGIN, MARGIN, panel_width, panel_height, sf::Color(0, 0, 0, 170));
+
+    const sf::Color ink(255, 255, 255);
+    for (size_t row = 0; row < lines.size(); ++row) {
+        float top = MARGIN + (PADDING + static_cast<float>(row * LINE_HEIGHT)) * scale_;
+        for (size_t column = 0; column < lines[row].size(); ++column) {
+            uint16_t bits = glyph(lines[row][column]);
+            float left = MARGIN + (PADDING + static_cast<float>(column * ADVANCE)) * scale_;
+            for (int y = 0; bits && y < GLYPH_HEIGHT; ++y) {
+                for (int x = 0; x < GLYPH_WIDTH; ++x) {
+                    int bit = (GLYPH_HEIGHT - 1 - y) * GLYPH_WIDTH + (GLYPH_WIDTH - 1 - x);
+                    if (bits & (1u << bit)) {
+                        append_quad(vertices_, left + x * scale_, top + y * scale_, scale_, scale_, ink);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void TextOverlay::draw(sf::RenderTarget& target, sf::RenderStates states) const
+{
+    if (vertices_.getVertexCount() == 0) return;
+    // Window pixels, whatever the camera is doing.
+    sf::View previous = target.getView();
+    target.setView(target.getDefaultView());
+    if (right_aligned_) {
+        states.transform.translate(target.getDefaultView().getSize().x - panel_width_ - 2 * MARGIN, 0.0f);
+    }
+    target.draw(vertices_, states);
+    target.setView(previous);
+}
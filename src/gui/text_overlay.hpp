@@ -0,0 +1,34 @@
+#ifndef TEXT_OVERLAY_HPP
+#define TEXT_OVERLAY_HPP
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+
+// A few lines of text on a translucent panel, drawn in window pixels. The
+// glyphs come from a built-in 3x5 pixel font and every lit pixel is a quad
+// in one vertex array, so no font file is needed and a frame costs one draw
+// call. The font knows upper case letters, digits and common punctuation;
+// lower case is drawn as upper case and anything else as a blank.
+class TextOverlay : public sf::Drawable
+{
+public:
+    // `scale` is the size of one font pixel in window pixels. The panel sits
+    // in the top-left corner of the window, or the top-right one.
+    explicit TextOverlay(float scale = 3.0f, bool right_aligned = false);
+
+    // Replaces the text.
+    void set_lines(const std::vector<std::string>& lines);
+    void clear() { vertices_.clear(); }
+
+protected:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+private:
+    float scale_;
+    bool right_aligned_;
+    float panel_width_ = 0.0f;
+    sf::VertexArray vertices_;
+};
+
+#endif // TEXT_OVERLAY_HPP
@@ -0,0 +1,153 @@
+#include "incremental_solver.hpp"
+
+#include <algorithm>
+
+IncrementalSolver::IncrementalSolver(const Grid& grid)
+    : grid_(grid)
+{
+    reset();
+}
+
+void IncrementalSolver::reset()
+{
+    size_t count = static_cast<size_t>(grid_.size());
+    g_.assign(count, UNREACHED);
+    rhs_.assign(count, UNREACHED);
+    touched_.assign(count, 0);
+    touched_cells_.clear();
+    open_.clear();
+    root_ = NO_CELL;
+    target_ = NO_CELL;
+}
+
+void IncrementalSolver::restart(int32_t root)
+{
+    for (int32_t cell : touched_cells_) {
+        g_[cell] = UNREACHED;
+        rhs_[cell] = UNREACHED;
+        touched_[cell] = 0;
+    }
+    touched_cells_.clear();
+    open_.clear();
+
+    root_ = root;
+    touch(root);
+    rhs_[root] = 0;
+    open_.push({0, root});
+}
+
+void IncrementalSolver::touch(int32_t cell)
+{
+    if (!touched_[cell]) {
+        touched_[cell] = 1;
+        touched_cells_.push_back(cell);
+    }
+}
+
+// LPA*'s UpdateVertex: recomputes rhs from the open neighbours and queues the
+// cell while it is inconsistent. Entering the cell costs grid_.cost(cell).
+void IncrementalSolver::update_cell(int32_t cell)
+{
+    if (cell != root_) {
+        int32_t nearest = UNREACHED;
+        uint8_t walls = grid_[cell].walls();
+        for (int dir = 0; dir < 4; ++dir) {
+            if (walls & (1u << dir)) continue;
+            nearest = std::min(nearest, g_[grid_.open_neighbour(cell, dir)]);
+        }
+        int32_t best = nearest == UNREACHED ? UNREACHED : nearest + grid_.cost(cell);
+        if (best != rhs_[cell]) {
+            touch(cell);
+            rhs_[cell] = best;
+        }
+    }
+    if (g_[cell] != rhs_[cell]) open_.push({key(cell), cell});
+}
+
+// Expands cells in key order until the target is consistent and nothing
+// queued could still shorten it. A zero heuristic makes both components of
+// the LPA* key equal, so a single integer suffices.
+int64_t IncrementalSolver::compute(int32_t target)
+{
+    int64_t expanded = 0;
+    while (!open_.empty()) {
+        std::pair<int32_t, int32_t> top = open_.top();
+        int32_t cell = top.second;
+        if (g_[cell] == rhs_[cell] || key(cell) != top.first) {
+            open_.pop();
+            continue;
+        }
+        if (top.first >= key(target) && g_[target] == rhs_[target]) break;
+        open_.pop();
+        ++expanded;
+
+        touch(cell);
+        if (g_[cell] > rhs_[cell]) {
+            g_[cell] = rhs_[cell];
+        } else {
+            g_[cell] = UNREACHED;
+            update_cell(cell);
+        }
+        uint8_t walls = grid_[cell].walls();
+        for (int dir = 0; dir < 4; ++dir) {
+            if (!(walls & (1u << dir))) update_cell(grid_.open_neighbour(cell, dir));
+        }
+    }
+    return expanded;
+}
+
+// Walks downhill in g from `cell` to the root. Every cell on a shortest path
+// to a consistent target is itself consistent, so g is exact along the way.
+std::vector<int32_t> IncrementalSolver::path_to_root(int32_t cell) const
+{
+    std::vector<int32_t> path;
+    if (g_[cell] == UNREACHED) return path;
+    path.push_back(cell);
+    while (cell != root_) {
+        uint8_t walls = grid_[cell].walls();
+        int32_t next = NO_CELL;
+        for (int dir = 0; dir < 4 && next == NO_CELL; ++dir) {
+            if (walls & (1u << dir)) continue;
+            int32_t neighbour = grid_.open_neighbour(cell, dir);
+            if (g_[neighbour] == g_[cell] - grid_.cost(cell)) next = neighbour;
+        }
+        if (next == NO_CELL) return {};
+        cell = next;
+        path.push_back(cell);
+    }
+    return path;
+}
+
+SolveResult IncrementalSolver::solve(int32_t start_cell, int32_t end_cell)
+{
+    SolveResult result;
+    if (start_cell == NO_CELL || end_cell == NO_CELL) return result;
+    if (g_.size() != static_cast<size_t>(grid_.size())) reset();
+
+    if (root_ != start_cell && root_ != end_cell) {
+        // The root moved. Re-root at the endpoint that was the target, which
+        // has not moved, so the next move of this marker is incremental.
+        restart(end_cell == target_ ? end_cell : start_cell);
+    }
+    target_ = root_ == start_cell ? end_cell : start_cell;
+
+    result.expanded = compute(target_);
+    result.path = path_to_root(target_);
+    if (root_ == start_cell) std::reverse(result.path.begin(), result.path.end());
+    for (size_t i = 1; i < result.path.size(); ++i) result.cost += grid_.cost(result.path[i]);
+    return result;
+}
+
+void IncrementalSolver::wall_changed(int32_t cell, int dir)
+{
+    if (root_ == NO_CELL) return;
+    int32_t other = grid_.neighbour(cell, dir);
+    update_cell(cell);
+    if (other != NO_CELL) update_cell(other);
+}
+
+void IncrementalSolver::cost_changed(int32_t cell)
+{
+    if (root_ == NO_CELL) return;
+    update_cell(cell);
+}
@@ -0,0 +1,46 @@
+#include "job_scheduler.hpp"
+
+JobScheduler::JobScheduler(int thread_count)
+{
+    if (thread_count <= 0) thread_count = 2;
+    for (int i = 0; i < thread_count; ++i) {
+        threads_.emplace_back(&JobScheduler::worker_loop, this);
+    }
+}
+
+JobScheduler::~JobScheduler()
+{
+    std::deque<std::function<void()>> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        dropped.swap(queue_);
+    }
+    wake_.notify_all();
+    for (std::thread& thread : threads_) thread.join();
+    // `dropped` goes out of scope here, breaking the queued jobs' promises.
+}
+
+void JobScheduler::enqueue(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(task));
+    }
+    wake_.notify_one();
+}
+
+void JobScheduler::worker_loop()
+{
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (stopping_) return;
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        task();
+    }
+}
@@ -1,57 +1,72 @@
 #include "maze_creators.hpp"
 #include "maze_utils.hpp"
+#include "perf_counters.hpp"
+#include "rng.hpp"
+#include "union_find.hpp"
 
 #include <stack>
+#include <vector>
 #include <algorithm>
-#include <thread>
-#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
 
-void create_dfs_maze(std::vector<std::vector<Cell>>& cells, Cell* start_cell, Cell* end_cell, std::atomic<bool>* is_running)
+void create_dfs_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running)
 {
-    cells_reset(cells);
-    std::stack<Cell*> stack;
+    PerfTimer timer(PerfPhase::Generate, "dfs");
+    PerfTally tally;
+    cells_reset(grid);
+    Rng rng(seed);
+    std::stack<int32_t, std::vector<int32_t>> stack;
 
-    if(start_cell == nullptr)
+    if(start_cell == NO_CELL)
     {
-        start_cell = &cells[0][0];
+        start_cell = 0;
     }
     else
     {
-        start_cell->type = CellType::Start;
+        grid[start_cell].set_type(CellType::Start);
     }
-    if (end_cell)
+    if (end_cell != NO_CELL)
     {
-        end_cell->type = CellType::End;
+        grid[end_cell].set_type(CellType::End);
+        grid.publish(end_cell);
     }
 
-    start_cell->visited = true;
-    if(is_running) start_cell->type = CellType::Path;
+    grid[start_cell].set_visited(true);
+    if(is_running) grid[start_cell].set_type(CellType::Path);
+    grid.publish(start_cell);
     stack.push(start_cell);
 
     while(!stack.empty())
     {
         if (is_running && !is_running->load()) break;
 
-        Cell* current = stack.top();
-        std::vector<Cell*> unvisited_neighbours = get_neighbours(current, cells, false);
+        int32_t current = stack.top();
+        NeighbourList unvisited_neighbours = get_neighbours(current, grid, false);
         
         if(!unvisited_neighbours.empty())
         {
-            std::shuffle(unvisited_neighbours.begin(), unvisited_neighbours.end(), g);
-            Cell* chosen = unvisited_neighbours.front();
+            int32_t chosen = unvisited_neighbours[rng.below(static_cast<uint32_t>(unvisited_neighbours.size()))];
             
-            removeWalls(*current, *chosen);
+            removeWalls(grid, current, chosen);
 
-            chosen->visited = true;
+            grid[chosen].set_visited(true);
             if(is_running) {
-                chosen->type = CellType::Path;
-                std::this_thread::sleep_for(std::chrono::milliseconds(15));
+                grid[chosen].set_type(CellType::Path);
+                grid.publish(current);
+                grid.publish(chosen);
             }
             stack.push(chosen);
+            tally.visit();
+            tally.frontier(stack.size());
         }
         else
         {
-            if(is_running) current->type = CellType::Visited;
+            if(is_running) {
+                grid[current].set_type(CellType::Visited);
+                grid.publish(current);
+            }
             stack.pop();
         }
     }
@@ -59,59 +74,710 @@ void create_dfs_maze(std::vector<std::vector<Cell>>& cells, Cell* start_cell, Ce
     if(is_running) *is_running = false;
 }
 
-void create_bfs_maze(std::vector<std::vector<Cell>>& cells, Cell* start_cell, Cell* end_cell, std::atomic<bool>* is_running)
+void create_bfs_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running)
 {
-    cells_reset(cells);
-    std::vector<Cell*> frontier;
+    PerfTimer timer(PerfPhase::Generate, "bfs");
+    PerfTally tally;
+    cells_reset(grid);
+    Rng rng(seed);
+    std::vector<int32_t> frontier;
+    std::vector<bool> in_frontier(grid.size(), false);
 
-    if(start_cell == nullptr)
+    if(start_cell == NO_CELL)
     {
-        start_cell = &cells[0][0];
+        start_cell = 0;
     }
     else
     {
-        start_cell->type = CellType::Start;
+        grid[start_cell].set_type(CellType::Start);
     }
-    if (end_cell)
+    if (end_cell != NO_CELL)
     {
-        end_cell->type = CellType::End;
+        grid[end_cell].set_type(CellType::End);
+        grid.publish(end_cell);
     }
     
-    start_cell->visited = true;
-    if(is_running) start_cell->type = CellType::Visited;
+    grid[start_cell].set_visited(true);
+    if(is_running) grid[start_cell].set_type(CellType::Visited);
+    grid.publish(start_cell);
     
-    add_neighbours_to_frontier(start_cell, cells, frontier);
+    add_neighbours_to_frontier(start_cell, grid, frontier, in_frontier, is_running != nullptr);
 
     while(!frontier.empty())
     {
         if (is_running && !is_running->load()) break;
 
-        int rand_index = g() % frontier.size();
-        Cell* current = frontier[rand_index];
-        frontier.erase(frontier.begin() + rand_index);
-
-        if(is_running) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        // Swap-and-pop: the frontier is unordered, so removal is O(1).
+        size_t rand_index = rng.below(static_cast<uint32_t>(frontier.size()));
+        int32_t current = frontier[rand_index];
+        frontier[rand_index] = frontier.back();
+        frontier.pop_back();
 
-        std::vector<Cell*> visited_neighbours = get_neighbours(current, cells, true);
-
-        if (!visited_neighbours.empty()) {
-            Cell* chosen_neighbour = visited_neighbours[g() % visited_neighbours.size()];
-            removeWalls(*current, *chosen_neighbour);
+        // Connect to a random visited neighbour, remembering its direction so
+        // the wall can be opened without searching for it.
+        int32_t around[4];
+        grid.neighbours(current, around);
+        int visited_dirs[4];
+        int visited_count = 0;
+        for (int dir = 0; dir < 4; ++dir) {
+            if (around[dir] != NO_CELL && grid[around[dir]].visited()) visited_dirs[visited_count++] = dir;
+        }
+        int32_t joined = NO_CELL;
+        if (visited_count > 0) {
+            int dir = visited_dirs[rng.below(static_cast<uint32_t>(visited_count))];
+            grid.remove_wall(current, dir);
+            joined = around[dir];
         }
 
-        current->visited = true;
-        if(is_running) current->type = CellType::Visited;
+        grid[current].set_visited(true);
+        if(is_running) {
+            grid[current].set_type(CellType::Visited);
+            grid.publish(current);
+            if (joined != NO_CELL) grid.publish(joined);
+        }
 
-        add_neighbours_to_frontier(current, cells, frontier);
+        add_neighbours_to_frontier(current, grid, frontier, in_frontier, is_running != nullptr);
+        tally.visit();
+        tally.frontier(frontier.size());
     }
 
     if(is_running) {
-        for(auto& row : cells) for(auto& cell : row) {
-            if (cell.type == CellType::Path || cell.type == CellType::Frontier) {
-                cell.type = CellType::Empty;
+        for(int32_t i = 0; i < grid.size(); ++i) {
+            CellType type = grid[i].type();
+            if (type == CellType::Path || type == CellType::Frontier) {
+                grid[i].set_type(CellType::Empty);
+                grid.publish(i);
             }
         }
     }
 
     if(is_running) *is_running = false;
 }
+
+namespace {
+
+// Shared prologue of the generators: clear the grid and paint the endpoints.
+void prepare_grid(Grid& grid, int32_t start_cell, int32_t end_cell)
+{
+    cells_reset(grid);
+    if (start_cell != NO_CELL) {
+        grid[start_cell].set_type(CellType::Start);
+        grid.publish(start_cell);
+    }
+    if (end_cell != NO_CELL) {
+        grid[end_cell].set_type(CellType::End);
+        grid.publish(end_cell);
+    }
+}
+
+void mark_visited(Grid& grid, int32_t cell)
+{
+    CellType type = grid[cell].type();
+    if (type != CellType::Start && type != CellType::End) grid[cell].set_type(CellType::Visited);
+}
+
+// Copies streamed rows into the grid, animating one row at a time.
+void fill_from_rows(Grid& grid, uint64_t seed, std::atomic<bool>* is_running, MazeStreamer stream)
+{
+    stream(grid.width(), grid.height(), seed, [&](int64_t y, const uint8_t* walls) {
+        if (is_running && !is_running->load()) return;
+        for (int x = 0; x < grid.width(); ++x) {
+            int32_t cell = grid.index(x, static_cast<int>(y));
+            grid[cell].set_walls(walls[x]);
+            grid[cell].set_visited(true);
+            if (is_running) {
+                mark_visited(grid, cell);
+                grid.publish(cell);
+            }
+        }
+    });
+}
+
+} // namespace
+
+void create_kruskal_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running)
+{
+    PerfTimer timer(PerfPhase::Generate, "kruskal");
+    PerfTally tally;
+    prepare_grid(grid, start_cell, end_cell);
+
+    // Wall ids are cell * 2 + 0 for the right wall and cell * 2 + 1 for the
+    // bottom wall; border walls are left out.
+    std::vector<uint32_t> walls;
+    walls.reserve(static_cast<size_t>(grid.size()) * 2);
+    for (int y = 0; y < grid.height(); ++y) {
+        for (int x = 0; x < grid.width(); ++x) {
+            uint32_t cell = static_cast<uint32_t>(grid.index(x, y));
+            if (x < grid.width() - 1) walls.push_back(cell * 2);
+            if (y < grid.height() - 1) walls.push_back(cell * 2 + 1);
+        }
+    }
+    Rng(seed).shuffle(walls.begin(), walls.end());
+
+    UnionFind regions(grid.size());
+    int32_t joined = 1;
+    for (uint32_t wall : walls) {
+        if (joined == grid.size()) break;
+        if (is_running && !is_running->load()) break;
+
+        int32_t cell = static_cast<int32_t>(wall / 2);
+        int dir = (wall & 1) ? DIR_BOTTOM : DIR_RIGHT;
+        int32_t other = grid.open_neighbour(cell, dir);
+        if (!regions.unite(cell, other)) continue;
+
+        grid.remove_wall(cell, dir);
+        ++joined;
+        tally.visit();
+        if (is_running) {
+            mark_visited(grid, cell);
+            mark_visited(grid, other);
+            grid.publish(cell);
+            grid.publish(other);
+        }
+    }
+
+    for (int32_t i = 0; i < grid.size(); ++i) grid[i].set_visited(true);
+    if (is_running) *is_running = false;
+}
+
+void create_wilson_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running)
+{
+    PerfTimer timer(PerfPhase::Generate, "wilson");
+    PerfTally tally;
+    prepare_grid(grid, start_cell, end_cell);
+
+    // exit_dir[cell] is the direction the walk last left the cell by.
+    // Following it from the walk's start yields the loop-erased path.
+    std::vector<uint8_t> exit_dir(grid.size(), 0);
+    Rng rng(seed);
+    grid[start_cell == NO_CELL ? 0 : start_cell].set_visited(true);
+
+    // Walks start from the cells in row order whatever the grid's layout,
+    // so a seed carves the same maze in every layout.
+    for (int32_t row_cell = 0; row_cell < grid.size(); ++row_cell) {
+        int32_t origin = grid.index(row_cell % grid.width(), row_cell / grid.width());
+        if (grid[origin].visited()) continue;
+        if (is_running && !is_running->load()) break;
+
+        int32_t current = origin;
+        while (!grid[current].visited()) {
+            int32_t around[4];
+            grid.neighbours(current, around);
+            int dirs[4];
+            int count = 0;
+            for (int dir = 0; dir < 4; ++dir) {
+                if (around[dir] != NO_CELL) dirs[count++] = dir;
+            }
+            int dir = dirs[rng.below(static_cast<uint32_t>(count))];
+            exit_dir[current] = static_cast<uint8_t>(dir);
+            current = around[dir];
+        }
+
+        current = origin;
+        while (!grid[current].visited()) {
+            int dir = exit_dir[current];
+            grid.remove_wall(current, dir);
+            grid[current].set_visited(true);
+            tally.visit();
+            int32_t next = grid.open_neighbour(current, dir);
+            if (is_running) {
+                mark_visited(grid, current);
+                grid.publish(current);
+                grid.publish(next);
+            }
+            current = next;
+        }
+    }
+
+    if (is_running) *is_running = false;
+}
+
+void stream_binary_tree_maze(int width, int64_t height, uint64_t seed, const MazeRowSink& sink)
+{
+    PerfTimer timer(PerfPhase::Generate, "binary-tree");
+    PerfTally tally;
+    Rng rng(seed);
+    std::vector<uint8_t> row(width);
+    std::vector<uint8_t> open_above(width, 0);
+    for (int64_t y = 0; y < height; ++y) {
+        bool last_row = y == height - 1;
+        std::fill(row.begin(), row.end(), ALL_WALLS);
+        for (int x = 0; x < width; ++x) {
+            if (open_above[x]) row[x] &= ~(1u << DIR_TOP);
+
+            bool can_east = x < width - 1;
+            bool can_south = !last_row;
+            bool south = can_south && (!can_east || rng.coin());
+            open_above[x] = south;
+            if (south) {
+                row[x] &= ~(1u << DIR_BOTTOM);
+            } else if (can_east) {
+                row[x] &= ~(1u << DIR_RIGHT);
+                row[x + 1] &= ~(1u << DIR_LEFT);
+            }
+        }
+        sink(y, row.data());
+        tally.visit(width);
+    }
+}
+
+void stream_sidewinder_maze(int width, int64_t height, uint64_t seed, const MazeRowSink& sink)
+{
+    PerfTimer timer(PerfPhase::Generate, "sidewinder");
+    PerfTally tally;
+    Rng rng(seed);
+    std::vector<uint8_t> row(width);
+    std::vector<uint8_t> open_above(width, 0);
+    for (int64_t y = 0; y < height; ++y) {
+        bool last_row = y == height - 1;
+        std::fill(row.begin(), row.end(), ALL_WALLS);
+        for (int x = 0; x < width; ++x) {
+            if (open_above[x]) row[x] &= ~(1u << DIR_TOP);
+        }
+        std::fill(open_above.begin(), open_above.end(), 0);
+
+        // Grow a run eastwards; when it closes, one random cell of the run
+        // carves south. The last row is a single run with no exit south.
+        int run_start = 0;
+        for (int x = 0; x < width; ++x) {
+            bool at_east_edge = x == width - 1;
+            bool close_run = at_east_edge || (!last_row && rng.coin());
+            if (close_run) {
+                if (!last_row) {
+                    int chosen = run_start + static_cast<int>(rng.below(static_cast<uint32_t>(x - run_start + 1)));
+                    row[chosen] &= ~(1u << DIR_BOTTOM);
+                    open_above[chosen] = 1;
+                }
+                run_start = x + 1;
+            } else {
+                row[x] &= ~(1u << DIR_RIGHT);
+                row[x + 1] &= ~(1u << DIR_LEFT);
+            }
+        }
+        sink(y, row.data());
+        tally.visit(width);
+    }
+}
+
+void stream_eller_maze(int width, int64_t height, uint64_t seed, const MazeRowSink& sink)
+{
+    PerfTimer timer(PerfPhase::Generate, "eller");
+    PerfTally tally;
+    Rng rng(seed);
+    // Set membership of the current row is a union-find over its columns;
+    // it is rebuilt for each new row from the downward passages.
+    std::vector<int32_t> parent(width);
+    std::vector<int32_t> roots(width);
+    std::vector<int32_t> representative(width);
+    std::vector<int32_t> members(width);
+    std::vector<int32_t> pick(width);
+    std::vector<uint8_t> has_down(width);
+    std::vector<uint8_t> row(width);
+    std::vector<uint8_t> open_above(width, 0);
+    for (int x = 0; x < width; ++x) parent[x] = x;
+
+    auto find = [&](int32_t x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    };
+
+    for (int64_t y = 0; y < height; ++y) {
+        bool last_row = y == height - 1;
+        std::fill(row.begin(), row.end(), ALL_WALLS);
+        for (int x = 0; x < width; ++x) {
+            if (open_above[x]) row[x] &= ~(1u << DIR_TOP);
+        }
+
+        // Randomly join neighbouring cells of different sets; the last row
+        // must join everything that is still separate.
+        for (int x = 0; x + 1 < width; ++x) {
+            int32_t a = find(x);
+            int32_t b = find(x + 1);
+            if (a == b || (!last_row && rng.coin())) continue;
+            parent[std::max(a, b)] = std::min(a, b);
+            row[x] &= ~(1u << DIR_RIGHT);
+            row[x + 1] &= ~(1u << DIR_LEFT);
+        }
+
+        if (last_row) {
+            sink(y, row.data());
+            tally.visit(width);
+            break;
+        }
+
+        // Every set continues downwards at least once: random columns go
+        // down, and a set that picked none uses a reservoir-sampled member.
+        for (int x = 0; x < width; ++x) {
+            roots[x] = find(x);
+            has_down[x] = 0;
+            members[x] = 0;
+        }
+        std::fill(open_above.begin(), open_above.end(), 0);
+        for (int x = 0; x < width; ++x) {
+            int32_t root = roots[x];
+            if (rng.below(static_cast<uint32_t>(++members[root])) == 0) pick[root] = x;
+            if (rng.coin()) {
+                open_above[x] = 1;
+                has_down[root] = 1;
+            }
+        }
+        for (int x = 0; x < width; ++x) {
+            if (roots[x] == x && !has_down[x]) open_above[pick[x]] = 1;
+        }
+        for (int x = 0; x < width; ++x) {
+            if (open_above[x]) row[x] &= ~(1u << DIR_BOTTOM);
+        }
+        sink(y, row.data());
+        tally.visit(width);
+
+        // Next row: cells below a passage inherit their set, others start alone.
+        std::fill(representative.begin(), representative.end(), -1);
+        for (int x = 0; x < width; ++x) {
+            parent[x] = x;
+            if (!open_above[x]) continue;
+            int32_t root = roots[x];
+            if (representative[root] < 0) representative[root] = x;
+            else parent[x] = representative[root];
+        }
+    }
+}
+
+void create_binary_tree_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running)
+{
+    prepare_grid(grid, start_cell, end_cell);
+    fill_from_rows(grid, seed, is_running, stream_binary_tree_maze);
+    if (is_running) *is_running = false;
+}
+
+void create_sidewinder_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running)
+{
+    prepare_grid(grid, start_cell, end_cell);
+    fill_from_rows(grid, seed, is_running, stream_sidewinder_maze);
+    if (is_running) *is_running = false;
+}
+
+void create_eller_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running)
+{
+    prepare_grid(grid, start_cell, end_cell);
+    fill_from_rows(grid, seed, is_running, stream_eller_maze);
+    if (is_running) *is_running = false;
+}
+
+namespace {
+
+// Iterative DFS confined to the tile [x0, x1) x [y0, y1).
+void carve_tile(Grid& grid, int x0, int y0, int x1, int y1, Rng& rng)
+{
+    // Runs on a pool thread, so it counts into that thread's slot.
+    PerfTally tally;
+    std::vector<int32_t> stack;
+    int32_t first = grid.index(x0, y0);
+    grid[first].set_visited(true);
+    stack.push_back(first);
+
+    while (!stack.empty()) {
+        int32_t current = stack.back();
+        int x = grid.x_of(current);
+        int y = grid.y_of(current);
+        int dirs[4];
+        int count = 0;
+        if (y > y0 && !grid[grid.open_neighbour(current, DIR_TOP)].visited()) dirs[count++] = DIR_TOP;
+        if (x < x1 - 1 && !grid[grid.open_neighbour(current, DIR_RIGHT)].visited()) dirs[count++] = DIR_RIGHT;
+        if (y < y1 - 1 && !grid[grid.open_neighbour(current, DIR_BOTTOM)].visited()) dirs[count++] = DIR_BOTTOM;
+        if (x > x0 && !grid[grid.open_neighbour(current, DIR_LEFT)].visited()) dirs[count++] = DIR_LEFT;
+
+        if (count == 0) {
+            stack.pop_back();
+            continue;
+        }
+        int dir = dirs[rng.below(static_cast<uint32_t>(count))];
+        int32_t chosen = grid.open_neighbour(current, dir);
+        grid.remove_wall(current, dir);
+        grid[chosen].set_visited(true);
+        stack.push_back(chosen);
+        tally.visit();
+        tally.frontier(stack.size());
+    }
+}
+
+// Edges of the tile graph: first all horizontal neighbours (tile, tile + 1),
+// then all vertical ones (tile, tile + tiles_x).
+struct TileGraph
+{
+    int tiles_x;
+    int tiles_y;
+    int32_t horizontal_edges;
+    int32_t edge_count;
+
+    TileGraph(int tiles_x_, int tiles_y_)
+        : tiles_x(tiles_x_), tiles_y(tiles_y_),
+          horizontal_edges(tiles_y_ * (tiles_x_ - 1)),
+          edge_count(horizontal_edges + (tiles_y_ - 1) * tiles_x_)
+    {
+    }
+
+    bool horizontal(int32_t edge) const { return edge < horizontal_edges; }
+
+    // Returns the upper/left tile of the edge; the other end is +1 or +tiles_x.
+    int32_t first_tile(int32_t edge) const
+    {
+        if (horizontal(edge)) {
+            int ty = edge / (tiles_x - 1);
+            return ty * tiles_x + edge % (tiles_x - 1);
+        }
+        return edge - horizontal_edges;
+    }
+
+    int32_t second_tile(int32_t edge) const
+    {
+        return first_tile(edge) + (horizontal(edge) ? 1 : tiles_x);
+    }
+
+    int incident_edges(int32_t tile, int32_t out[4]) const
+    {
+        int tx = tile % tiles_x;
+        int ty = tile / tiles_x;
+        int count = 0;
+        if (tx > 0) out[count++] = ty * (tiles_x - 1) + tx - 1;
+        if (tx < tiles_x - 1) out[count++] = ty * (tiles_x - 1) + tx;
+        if (ty > 0) out[count++] = horizontal_edges + tile - tiles_x;
+        if (ty < tiles_y - 1) out[count++] = horizontal_edges + tile;
+        return count;
+    }
+};
+
+// Parallel Boruvka over the tile graph. Every edge gets a distinct random
+// key, so the spanning tree is unique and independent of scheduling.
+std::vector<uint8_t> random_tile_tree(const TileGraph& graph, uint64_t seed, ThreadPool& pool)
+{
+    const int32_t tile_count = graph.tiles_x * graph.tiles_y;
+    const uint64_t none = UINT64_MAX;
+    auto edge_key = [seed](int32_t edge) {
+        return (mix64(seed ^ (static_cast<uint64_t>(edge) << 1)) & 0xFFFFFFFF00000000ull) | static_cast<uint32_t>(edge);
+    };
+
+    ConcurrentUnionFind components(tile_count);
+    std::unique_ptr<std::atomic<uint64_t>[]> cheapest(new std::atomic<uint64_t>[tile_count]);
+    std::vector<uint8_t> in_tree(graph.edge_count, 0);
+    const int64_t grain = 1024;
+
+    int32_t remaining = tile_count;
+    while (remaining > 1) {
+        pool.parallel_for(0, tile_count, [&](int64_t tile) {
+            cheapest[tile].store(none, std::memory_order_relaxed);
+        }, grain);
+
+        pool.parallel_for(0, tile_count, [&](int64_t tile) {
+            int32_t root = components.find(static_cast<int32_t>(tile));
+            int32_t edges[4];
+            int count = graph.incident_edges(static_cast<int32_t>(tile), edges);
+            for (int k = 0; k < count; ++k) {
+                int32_t other = graph.first_tile(edges[k]) == tile ? graph.second_tile(edges[k]) : graph.first_tile(edges[k]);
+                if (components.find(other) == root) continue;
+                uint64_t key = edge_key(edges[k]);
+                uint64_t current = cheapest[root].load(std::memory_order_relaxed);
+                while (key < current && !cheapest[root].compare_exchange_weak(current, key, std::memory_order_relaxed)) {
+                }
+            }
+        }, grain);
+
+        // Only roots from the previous phase hold a key, so this phase does
+        // not depend on roots changing underneath it.
+        std::atomic<int32_t> merged{0};
+        pool.parallel_for(0, tile_count, [&](int64_t tile) {
+            uint64_t key = cheapest[tile].load(std::memory_order_relaxed);
+            if (key == none) return;
+            int32_t edge = static_cast<int32_t>(key & 0xFFFFFFFFu);
+            if (components.unite(graph.first_tile(edge), graph.second_tile(edge))) {
+                in_tree[edge] = 1;
+                merged.fetch_add(1, std::memory_order_relaxed);
+            }
+        }, grain);
+
+        if (merged.load() == 0) break;
+        remaining -= merged.load();
+    }
+    return in_tree;
+}
+
+} // namespace
+
+void create_parallel_maze(Grid& grid, uint64_t seed, ThreadPool& pool, int tile_size)
+{
+    PerfTimer timer(PerfPhase::Generate, "parallel");
+    cells_reset(grid);
+    tile_size = std::max(2, tile_size);
+    const int tiles_x = (grid.width() + tile_size - 1) / tile_size;
+    const int tiles_y = (grid.height() + tile_size - 1) / tile_size;
+    TileGraph graph(tiles_x, tiles_y);
+
+    auto tile_bounds = [&](int32_t tile, int& x0, int& y0, int& x1, int& y1) {
+        x0 = (tile % tiles_x) * tile_size;
+        y0 = (tile / tiles_x) * tile_size;
+        x1 = std::min(grid.width(), x0 + tile_size);
+        y1 = std::min(grid.height(), y0 + tile_size);
+    };
+
+    pool.parallel_for(0, static_cast<int64_t>(tiles_x) * tiles_y, [&](int64_t tile) {
+        int x0, y0, x1, y1;
+        tile_bounds(static_cast<int32_t>(tile), x0, y0, x1, y1);
+        Rng rng(seed, static_cast<uint64_t>(tile));
+        carve_tile(grid, x0, y0, x1, y1, rng);
+    });
+
+    // Open one random wall along the shared border of every tree edge.
+    std::vector<uint8_t> in_tree = random_tile_tree(graph, seed, pool);
+    for (int32_t edge = 0; edge < graph.edge_count; ++edge) {
+        if (!in_tree[edge]) continue;
+        int x0, y0, x1, y1;
+        tile_bounds(graph.first_tile(edge), x0, y0, x1, y1);
+        uint64_t position = mix64(~seed ^ static_cast<uint64_t>(edge));
+        if (graph.horizontal(edge)) {
+            int y = y0 + static_cast<int>(position % static_cast<uint64_t>(y1 - y0));
+            grid.remove_wall(grid.index(x1 - 1, y), DIR_RIGHT);
+        } else {
+            int x = x0 + static_cast<int>(position % static_cast<uint64_t>(x1 - x0));
+            grid.remove_wall(grid.index(x, y1 - 1), DIR_BOTTOM);
+        }
+    }
+}
+
+void create_parallel_maze(Grid& grid, uint64_t seed, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running)
+{
+    create_parallel_maze(grid, seed, default_thread_pool());
+    if (start_cell != NO_CELL) grid[start_cell].set_type(CellType::Start);
+    if (end_cell != NO_CELL) grid[end_cell].set_type(CellType::End);
+    if (is_running) {
+        // The tiles are carved all at once, so the result is shown row by row.
+        for (int32_t i = 0; i < grid.size() && is_running->load(); ++i) grid.publish(i);
+        *is_running = false;
+    }
+}
+
+namespace {
+
+// Rng streams of the post-processing passes, kept apart from stream 0 that
+// the generators use so braiding never replays the generator's choices.
+constexpr uint64_t BRAID_STREAM = 0xB2A1D;
+constexpr uint64_t OPEN_WALLS_STREAM = 0x09E4;
+
+bool is_dead_end(const Cell& cell)
+{
+    return __builtin_popcount(cell.walls()) == 3;
+}
+
+} // namespace
+
+int64_t braid_maze(Grid& grid, uint64_t seed, double fraction)
+{
+    PerfTimer timer(PerfPhase::Generate, "braid");
+    std::vector<int32_t> dead_ends;
+    for (int y = 0; y < grid.height(); ++y) {
+        for (int x = 0; x < grid.width(); ++x) {
+            if (is_dead_end(grid.at(x, y))) dead_ends.push_back(grid.index(x, y));
+        }
+    }
+    fraction = std::clamp(fraction, 0.0, 1.0);
+    const int64_t target = std::llround(fraction * static_cast<double>(dead_ends.size()));
+    Rng rng(seed, BRAID_STREAM);
+    rng.shuffle(dead_ends.begin(), dead_ends.end());
+
+    int64_t removed = 0;
+    int64_t opened = 0;
+    for (int32_t cell : dead_ends) {
+        if (removed >= target) break;
+        // An earlier opening may already have joined this one to a neighbour.
+        if (!is_dead_end(grid[cell])) continue;
+
+        // Joining two dead ends removes both with one opening, and keeps the
+        // new loops short.
+        int32_t around[4];
+        grid.neighbours(cell, around);
+        int walled[4];
+        int dead[4];
+        int walled_count = 0;
+        int dead_count = 0;
+        for (int dir = 0; dir < 4; ++dir) {
+            if (around[dir] == NO_CELL || !grid[cell].has_wall(dir)) continue;
+            walled[walled_count++] = dir;
+            if (is_dead_end(grid[around[dir]])) dead[dead_count++] = dir;
+        }
+        if (walled_count == 0) continue;
+
+        const bool prefer_dead = dead_count > 0;
+        int dir = prefer_dead ? dead[rng.below(static_cast<uint32_t>(dead_count))]
+                              : walled[rng.below(static_cast<uint32_t>(walled_count))];
+        grid.remove_wall(cell, dir);
+        grid.publish(cell);
+        grid.publish(around[dir]);
+        removed += prefer_dead ? 2 : 1;
+        ++opened;
+    }
+    return opened;
+}
+
+int64_t open_random_walls(Grid& grid, uint64_t seed, double fraction)
+{
+    PerfTimer timer(PerfPhase::Generate, "open-walls");
+    // Interior walls encoded as cell * 2 + (0 for the east wall, 1 for the
+    // south wall); the border is never opened.
+    std::vector<int64_t> walls;
+    const int width = grid.width();
+    const int height = grid.height();
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int32_t i = grid.index(x, y);
+            if (x < width - 1 && grid[i].has_wall(DIR_RIGHT)) walls.push_back(int64_t{i} * 2);
+            if (y < height - 1 && grid[i].has_wall(DIR_BOTTOM)) walls.push_back(int64_t{i} * 2 + 1);
+        }
+    }
+    fraction = std::clamp(fraction, 0.0, 1.0);
+    const int64_t count = std::llround(fraction * static_cast<double>(walls.size()));
+
+    // Partial Fisher-Yates: only the chosen prefix is drawn.
+    Rng rng(seed, OPEN_WALLS_STREAM);
+    for (int64_t k = 0; k < count; ++k) {
+        int64_t remaining = static_cast<int64_t>(walls.size()) - k;
+        int64_t j = k + static_cast<int64_t>(remaining > UINT32_MAX ? rng.next() % static_cast<uint64_t>(remaining)
+                                                                    : rng.below(static_cast<uint32_t>(remaining)));
+        std::swap(walls[k], walls[j]);
+        int32_t cell = static_cast<int32_t>(walls[k] / 2);
+        int dir = walls[k] % 2 ? DIR_BOTTOM : DIR_RIGHT;
+        grid.remove_wall(cell, dir);
+        grid.publish(cell);
+        grid.publish(grid.open_neighbour(cell, dir));
+    }
+    return count;
+}
+
+const std::vector<MazeCreatorInfo>& maze_creator_list()
+{
+    static const std::vector<MazeCreatorInfo> creators = {
+        {"dfs", create_dfs_maze},
+        {"bfs", create_bfs_maze},
+        {"kruskal", create_kruskal_maze},
+        {"wilson", create_wilson_maze},
+        {"binary-tree", create_binary_tree_maze, stream_binary_tree_maze},
+        {"sidewinder", create_sidewinder_maze, stream_sidewinder_maze},
+        {"eller", create_eller_maze, stream_eller_maze},
+        {"parallel", static_cast<MazeCreator>(create_parallel_maze)},
+    };
+    return creators;
+}
+
+const MazeCreatorInfo* find_maze_creator_info(const std::string& name)
+{
+    for (const MazeCreatorInfo& info : maze_creator_list()) {
+        if (name == info.name) return &info;
+    }
+    return nullptr;
+}
+
+MazeCreator find_maze_creator(const std::string& name)
+{
+    const MazeCreatorInfo* info = find_maze_creator_info(name);
+    return info ? info->create : nullptr;
+}
@@ -0,0 +1,186 @@
+#include "maze_file.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+const char MAZE_MAGIC[4] = {'V', 'M', 'A', 'Z'};
+
+std::runtime_error file_error(const std::string& path, const std::string& what)
+{
+    return std::runtime_error(path + ": " + what);
+}
+
+} // namespace
+
+MazeFileWriter::MazeFileWriter(const std::string& path, int width, int64_t height, uint64_t seed, const std::string& generator)
+    : path_(path), width_(width), height_(height), packed_(maze_file_row_bytes(width))
+{
+    if (width <= 0 || height <= 0) throw std::invalid_argument("Maze size must be positive");
+
+    MazeFileHeader header{};
+    std::memcpy(header.magic, MAZE_MAGIC, sizeof(header.magic));
+    header.version = MAZE_FILE_VERSION;
+    header.header_size = sizeof(MazeFileHeader);
+    header.width = static_cast<uint32_t>(width);
+    header.height = static_cast<uint64_t>(height);
+    header.seed = seed;
+    std::strncpy(header.generator, generator.c_str(), sizeof(header.generator) - 1);
+
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) throw file_error(path, "cannot open for writing");
+    // Rows are written in large sequential chunks; a bigger stdio buffer
+    // keeps the syscall count low for narrow mazes.
+    std::setvbuf(file_, nullptr, _IOFBF, 1 << 20);
+    // The destructor does not run for a constructor that throws.
+    if (std::fwrite(&header, sizeof(header), 1, file_) != 1) {
+        std::fclose(file_);
+        file_ = nullptr;
+        throw file_error(path, "write failed");
+    }
+}
+
+MazeFileWriter::~MazeFileWriter()
+{
+    if (file_) std::fclose(file_);
+}
+
+void MazeFileWriter::write_row(const uint8_t* walls)
+{
+    if (rows_written_ >= height_) throw file_error(path_, "more rows written than the header declares");
+    for (int64_t b = 0; b < static_cast<int64_t>(packed_.size()); ++b) {
+        int64_t x = b * 2;
+        uint8_t low = walls[x] & ALL_WALLS;
+        uint8_t high = x + 1 < width_ ? walls[x + 1] & ALL_WALLS : ALL_WALLS;
+        packed_[b] = static_cast<uint8_t>(low | (high << 4));
+    }
+    if (std::fwrite(packed_.data(), 1, packed_.size(), file_) != packed_.size()) throw file_error(path_, "write failed");
+    ++rows_written_;
+}
+
+void MazeFileWriter::finish()
+{
+    if (rows_written_ != height_) throw file_error(path_, "fewer rows written than the header declares");
+    int failed = std::fclose(file_);
+    file_ = nullptr;
+    if (failed) throw file_error(path_, "write failed");
+}
+
+MappedMaze::MappedMaze(const std::string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw file_error(path, "cannot open");
+    struct stat info{};
+    if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(MazeFileHeader))) {
+        ::close(fd);
+        throw file_error(path, "not a maze file");
+    }
+    mapping_size_ = static_cast<size_t>(info.st_size);
+    mapping_ = ::mmap(nullptr, mapping_size_, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        throw file_error(path, "mmap failed");
+    }
+
+    MazeFileHeader header;
+    std::memcpy(&header, mapping_, sizeof(header));
+    if (std::memcmp(header.magic, MAZE_MAGIC, sizeof(header.magic)) != 0 || header.version != MAZE_FILE_VERSION
+        || header.header_size < sizeof(MazeFileHeader) || header.width == 0 || header.width > INT32_MAX
+        || header.height == 0) {
+        release();
+        throw file_error(path, "not a maze file");
+    }
+    // Checked before the row count below subtracts it from the file size.
+    if (header.header_size > mapping_size_) {
+        release();
+        throw file_error(path, "truncated maze file");
+    }
+
+    width_ = static_cast<int>(header.width);
+    height_ = static_cast<int64_t>(header.height);
+    row_bytes_ = maze_file_row_bytes(width_);
+    if (static_cast<uint64_t>(height_) > (mapping_size_ - header.header_size) / row_bytes_) {
+        release();
+        throw file_error(path, "truncated maze file");
+    }
+    seed_ = header.seed;
+    header.generator[sizeof(header.generator) - 1] = '\0';
+    generator_ = header.generator;
+    rows_ = static_cast<const uint8_t*>(mapping_) + header.header_size;
+    offsets_[DIR_TOP] = -static_cast<int64_t>(width_);
+    offsets_[DIR_RIGHT] = 1;
+    offsets_[DIR_BOTTOM] = width_;
+    offsets_[DIR_LEFT] = -1;
+}
+
+MappedMaze::~MappedMaze()
+{
+    release();
+}
+
+MappedMaze::MappedMaze(MappedMaze&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedMaze& MappedMaze::operator=(MappedMaze&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        mapping_ = std::exchange(other.mapping_, nullptr);
+        mapping_size_ = std::exchange(other.mapping_size_, 0);
+        rows_ = std::exchange(other.rows_, nullptr);
+        row_bytes_ = other.row_bytes_;
+        width_ = other.width_;
+        height_ = other.height_;
+        std::memcpy(offsets_, other.offsets_, sizeof(offsets_));
+        seed_ = other.seed_;
+        generator_ = std::move(other.generator_);
+    }
+    return *this;
+}
+
+void MappedMaze::release()
+{
+    if (mapping_) ::munmap(mapping_, mapping_size_);
+    mapping_ = nullptr;
+    rows_ = nullptr;
+}
+
+void save_maze(const Grid& grid, const std::string& path, uint64_t seed, const std::string& generator)
+{
+    MazeFileWriter writer(path, grid.width(), grid.height(), seed, generator);
+    std::vector<uint8_t> row(grid.width());
+    for (int y = 0; y < grid.height(); ++y) {
+        for (int x = 0; x < grid.width(); ++x) row[x] = grid.at(x, y).walls();
+        writer.write_row(row.data());
+    }
+    writer.finish();
+}
+
+Grid load_maze(const std::string& path, GridLayout layout)
+{
+    MappedMaze maze(path);
+    if (maze.height() > INT32_MAX) throw std::invalid_argument("Maze too large to load into a Grid");
+    Grid grid(maze.width(), static_cast<int>(maze.height()), layout);
+    for (int y = 0; y < grid.height(); ++y) {
+        for (int x = 0; x < grid.width(); ++x) {
+            int32_t i = grid.index(x, y);
+            grid[i].set_walls(maze.walls(maze.index(x, y)));
+            grid[i].set_visited(true);
+            // A wall only one side of a damaged file has open stays closed,
+            // so the Grid never holds a one-way passage.
+            if (x > 0 && grid.at(x - 1, y).has_wall(DIR_RIGHT) != grid[i].has_wall(DIR_LEFT)) grid.add_wall(i, DIR_LEFT);
+            if (y > 0 && grid.at(x, y - 1).has_wall(DIR_BOTTOM) != grid[i].has_wall(DIR_TOP)) grid.add_wall(i, DIR_TOP);
+        }
+    }
+    return grid;
+}
@@ -1,91 +1,710 @@
 #include "maze_solvers.hpp"
-#include "maze_utils.hpp"
+#include "maze_file.hpp"
+#include "perf_counters.hpp"
+#include "priority_queues.hpp"
+#include "thread_pool.hpp"
 
 #include <vector>
 #include <algorithm>
-#include <thread>
-#include <chrono>
 #include <climits>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 
-void dijkstra_solve(std::vector<std::vector<Cell>>& cells, Cell* start_cell, Cell* end_cell, std::atomic<bool>* is_running)
+namespace {
+
+constexpr uint8_t NO_PARENT = 0xFF;
+constexpr uint8_t ROOT = 4;
+
+// Search hooks for the headless path; everything inlines away but the
+// counter updates. frontier() reports the size of the open set after a push.
+struct HeadlessVisitor
 {
-    if (!start_cell || !end_cell) {
-        if (is_running) *is_running = false;
-        return;
+    PerfTally tally;
+
+    bool expand(int32_t) { tally.visit(); return true; }
+    void discover(int32_t) {}
+    void frontier(size_t size) { tally.frontier(size); }
+    bool enter(int32_t) const { return true; }
+    bool fill(int32_t) { tally.visit(); return true; }
+};
+
+// Search hooks for the visualiser: paints the search as it runs and stops
+// when the GUI clears is_running.
+struct AnimatedVisitor
+{
+    Grid& grid;
+    std::atomic<bool>* is_running;
+    PerfTally tally;
+
+    bool expand(int32_t cell)
+    {
+        tally.visit();
+        if (!is_running) return true;
+        if (!is_running->load()) return false;
+        mark(cell, CellType::Visited);
+        return true;
     }
 
-    for(auto& row : cells) for(auto& cell : row) {
-        cell.visited = false;
-        cell.parent = nullptr;
-        if (cell.type == CellType::Path || cell.type == CellType::Visited || cell.type == CellType::Frontier) {
-            if (cell.type != CellType::Start && cell.type != CellType::End)
-                cell.type = CellType::Empty;
+    void discover(int32_t cell)
+    {
+        if (is_running) mark(cell, CellType::Frontier);
+    }
+
+    void frontier(size_t size) { tally.frontier(size); }
+
+    bool enter(int32_t) const { return true; }
+
+    // Dead-end filling shades the filled cells like expanded ones.
+    bool fill(int32_t cell) { return expand(cell); }
+
+    void mark(int32_t cell, CellType type)
+    {
+        CellType current = grid[cell].type();
+        if (current != CellType::Start && current != CellType::End) {
+            grid[cell].set_type(type);
+            grid.publish(cell);
         }
     }
+};
+
+// Keeps a search out of the cells removed by dead-end filling.
+template <class Inner>
+struct PrunedVisitor
+{
+    Inner& inner;
+    const uint8_t* pruned;
+
+    bool expand(int32_t cell) { return inner.expand(cell); }
+    void discover(int32_t cell) { inner.discover(cell); }
+    void frontier(size_t size) { inner.frontier(size); }
+    bool enter(int32_t cell) const { return !pruned[cell] && inner.enter(cell); }
+    bool fill(int32_t cell) { return inner.fill(cell); }
+};
+
+// parent[cell] holds the direction from cell towards the search root.
+std::vector<int32_t> chain_to_root(const Grid& grid, const std::vector<uint8_t>& parent, int32_t cell)
+{
+    std::vector<int32_t> chain;
+    while (parent[cell] != ROOT) {
+        chain.push_back(cell);
+        cell = grid.open_neighbour(cell, parent[cell]);
+    }
+    chain.push_back(cell);
+    return chain;
+}
+
+std::vector<int32_t> trace_path(const Grid& grid, const std::vector<uint8_t>& parent, int32_t end_cell)
+{
+    std::vector<int32_t> path = chain_to_root(grid, parent, end_cell);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+// Pops from the front of a vector used as a FIFO, reclaiming the consumed
+// prefix now and then so memory tracks the frontier rather than the grid.
+template <class Index>
+void compact_queue(std::vector<Index>& queue, size_t& head)
+{
+    if (head >= 4096 && head * 2 >= queue.size()) {
+        queue.erase(queue.begin(), queue.begin() + head);
+        head = 0;
+    }
+}
 
-    std::vector<Cell*> unvisited;
-    std::vector<std::vector<int>> distance(GRID_WIDTH, std::vector<int>(GRID_HEIGHT, INT_MAX));
+template <class Visitor>
+SolveResult search_bfs(const Grid& grid, int32_t start_cell, int32_t end_cell, Visitor& visitor)
+{
+    SolveResult result;
+    std::vector<uint8_t> parent(grid.size(), NO_PARENT);
+    std::vector<int32_t> queue;
+    size_t head = 0;
 
-    distance[start_cell->x][start_cell->y] = 0;
-    unvisited.push_back(start_cell);
+    parent[start_cell] = ROOT;
+    queue.push_back(start_cell);
+    while (head < queue.size()) {
+        int32_t current = queue[head++];
+        compact_queue(queue, head);
+        if (!visitor.expand(current)) return result;
+        ++result.expanded;
+        if (current == end_cell) {
+            result.path = trace_path(grid, parent, end_cell);
+            return result;
+        }
+
+        Cell cell = grid[current];
+        for (int dir = 0; dir < 4; ++dir) {
+            if (cell.has_wall(dir)) continue;
+            int32_t next = grid.open_neighbour(current, dir);
+            if (parent[next] != NO_PARENT || !visitor.enter(next)) continue;
+            parent[next] = static_cast<uint8_t>(opposite(dir));
+            queue.push_back(next);
+            visitor.discover(next);
+        }
+        visitor.frontier(queue.size() - head);
+    }
+    return result;
+}
 
-    Cell* current = nullptr;
-    while(!unvisited.empty()) {
-        if (is_running && !is_running->load()) break;
+// Dijkstra over the cell costs with any monotone queue taking int32 keys:
+// a radix heap, or a bucket queue with max_cost() + 1 buckets for Dial's
+// algorithm.
+template <class Queue, class Visitor>
+SolveResult search_dijkstra(const Grid& grid, int32_t start_cell, int32_t end_cell, Queue& queue, Visitor& visitor)
+{
+    SolveResult result;
+    std::vector<int32_t> distance(grid.size(), INT32_MAX);
+    std::vector<uint8_t> parent(grid.size(), NO_PARENT);
 
-        std::sort(unvisited.begin(), unvisited.end(), [&](Cell* a, Cell* b) {
-            return distance[a->x][a->y] > distance[b->x][b->y];
-        });
-        current = unvisited.back();
-        unvisited.pop_back();
+    distance[start_cell] = 0;
+    parent[start_cell] = ROOT;
+    queue.push(0, start_cell);
+    while (!queue.empty()) {
+        std::pair<int32_t, int32_t> top = queue.pop();
+        int32_t current = top.second;
+        if (top.first > distance[current]) continue;
+        if (!visitor.expand(current)) return result;
+        ++result.expanded;
+        if (current == end_cell) {
+            result.path = trace_path(grid, parent, end_cell);
+            return result;
+        }
 
-        if (current->type != CellType::Start && current->type != CellType::End) {
-            current->type = CellType::Path;
+        Cell cell = grid[current];
+        for (int dir = 0; dir < 4; ++dir) {
+            if (cell.has_wall(dir)) continue;
+            int32_t next = grid.open_neighbour(current, dir);
+            if (!visitor.enter(next)) continue;
+            int32_t new_dist = top.first + grid.cost(next);
+            if (new_dist < distance[next]) {
+                distance[next] = new_dist;
+                parent[next] = static_cast<uint8_t>(opposite(dir));
+                queue.push(new_dist, next);
+                visitor.discover(next);
+            }
         }
-        if (is_running) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        visitor.frontier(queue.size());
+    }
+    return result;
+}
+
+struct AStarEntry
+{
+    int32_t f;
+    int32_t g;
+    int32_t cell;
+};
+
+// Lower f first; among equal f prefer the deeper node, which heads straight
+// for the goal instead of widening the search.
+struct AStarLess
+{
+    bool operator()(const AStarEntry& a, const AStarEntry& b) const
+    {
+        return a.f != b.f ? a.f < b.f : a.g > b.g;
+    }
+};
 
-        if (current == end_cell) break;
+template <class Visitor>
+SolveResult search_astar(const Grid& grid, int32_t start_cell, int32_t end_cell, Visitor& visitor)
+{
+    SolveResult result;
+    std::vector<int32_t> distance(grid.size(), INT32_MAX);
+    std::vector<uint8_t> parent(grid.size(), NO_PARENT);
+    DaryHeap<AStarEntry, AStarLess> open;
+    const int end_x = grid.x_of(end_cell);
+    const int end_y = grid.y_of(end_cell);
+    // Every step enters a cell costing at least min_cost(), so the Manhattan
+    // distance scaled by it never overestimates: admissible and consistent.
+    const int step = grid.min_cost();
+    auto heuristic = [&](int32_t cell) {
+        return step * (std::abs(grid.x_of(cell) - end_x) + std::abs(grid.y_of(cell) - end_y));
+    };
+
+    distance[start_cell] = 0;
+    parent[start_cell] = ROOT;
+    open.push({heuristic(start_cell), 0, start_cell});
+    while (!open.empty()) {
+        AStarEntry top = open.top();
+        open.pop();
+        if (top.g > distance[top.cell]) continue;
+        if (!visitor.expand(top.cell)) return result;
+        ++result.expanded;
+        if (top.cell == end_cell) {
+            result.path = trace_path(grid, parent, end_cell);
+            return result;
+        }
 
-        if (current->type != CellType::Start && current->type != CellType::End) {
-            current->type = CellType::Visited;
+        Cell cell = grid[top.cell];
+        for (int dir = 0; dir < 4; ++dir) {
+            if (cell.has_wall(dir)) continue;
+            int32_t next = grid.open_neighbour(top.cell, dir);
+            if (!visitor.enter(next)) continue;
+            int32_t new_g = top.g + grid.cost(next);
+            if (new_g < distance[next]) {
+                distance[next] = new_g;
+                parent[next] = static_cast<uint8_t>(opposite(dir));
+                open.push({new_g + heuristic(next), new_g, next});
+                visitor.discover(next);
+            }
         }
-        current->visited = true;
+        visitor.frontier(open.size());
+    }
+    return result;
+}
+
+template <class Visitor>
+SolveResult search_bidirectional(const Grid& grid, int32_t start_cell, int32_t end_cell, Visitor& visitor)
+{
+    enum : uint8_t { UNSEEN = 0, FORWARD = 1, BACKWARD = 2 };
 
-        std::vector<Cell*> traversable_neighbours = get_neighbours(current, cells);
+    SolveResult result;
+    std::vector<uint8_t> side(grid.size(), UNSEEN);
+    std::vector<uint8_t> parent(grid.size(), NO_PARENT);
+    std::vector<int32_t> distance(grid.size(), 0);
+    std::vector<int32_t> frontiers[3];
+    std::vector<int32_t> next_level;
 
-        for (Cell* neighbour : traversable_neighbours) {
-            int new_dist = distance[current->x][current->y] + 1;
-            if (new_dist < distance[neighbour->x][neighbour->y]) {
-                distance[neighbour->x][neighbour->y] = new_dist;
-                neighbour->parent = current;
-                
-                bool in_unvisited = false;
-                for(Cell* u_cell : unvisited) if(u_cell == neighbour) in_unvisited = true;
-                if(!in_unvisited) {
-                    unvisited.push_back(neighbour);
-                    if(neighbour->type != CellType::End) neighbour->type = CellType::Frontier;
+    side[start_cell] = FORWARD;
+    parent[start_cell] = ROOT;
+    frontiers[FORWARD].push_back(start_cell);
+    if (start_cell == end_cell) {
+        result.path.push_back(start_cell);
+        return result;
+    }
+    side[end_cell] = BACKWARD;
+    parent[end_cell] = ROOT;
+    frontiers[BACKWARD].push_back(end_cell);
+
+    while (!frontiers[FORWARD].empty() && !frontiers[BACKWARD].empty()) {
+        // Grow the smaller frontier by one whole level; the first level that
+        // touches the other side holds the shortest meeting point.
+        uint8_t growing = frontiers[FORWARD].size() <= frontiers[BACKWARD].size() ? FORWARD : BACKWARD;
+        uint8_t other = growing == FORWARD ? BACKWARD : FORWARD;
+        int32_t best_length = INT32_MAX;
+        int32_t meet_near = NO_CELL;
+        int32_t meet_far = NO_CELL;
+
+        next_level.clear();
+        for (int32_t current : frontiers[growing]) {
+            if (!visitor.expand(current)) return result;
+            ++result.expanded;
+
+            Cell cell = grid[current];
+            for (int dir = 0; dir < 4; ++dir) {
+                if (cell.has_wall(dir)) continue;
+                int32_t next = grid.open_neighbour(current, dir);
+                if (!visitor.enter(next)) continue;
+                if (side[next] == UNSEEN) {
+                    side[next] = growing;
+                    parent[next] = static_cast<uint8_t>(opposite(dir));
+                    distance[next] = distance[current] + 1;
+                    next_level.push_back(next);
+                    visitor.discover(next);
+                } else if (side[next] == other) {
+                    int32_t length = distance[current] + 1 + distance[next];
+                    if (length < best_length) {
+                        best_length = length;
+                        meet_near = current;
+                        meet_far = next;
+                    }
                 }
             }
         }
+
+        if (meet_near != NO_CELL) {
+            int32_t forward_end = growing == FORWARD ? meet_near : meet_far;
+            int32_t backward_end = growing == FORWARD ? meet_far : meet_near;
+            result.path = trace_path(grid, parent, forward_end);
+            std::vector<int32_t> tail = chain_to_root(grid, parent, backward_end);
+            result.path.insert(result.path.end(), tail.begin(), tail.end());
+            return result;
+        }
+        visitor.frontier(next_level.size() + frontiers[other].size());
+        frontiers[growing].swap(next_level);
+    }
+    return result;
+}
+
+// Dead-end filling: repeatedly fills every cell, other than the endpoints,
+// with at most one open side to a cell that is not yet filled. What is left
+// is every cell that lies on some loop-free start-end path, plus any loops
+// cut off from both endpoints. Returns false when the visitor stops it.
+template <class Visitor>
+bool fill_dead_ends(const Grid& grid, int32_t start_cell, int32_t end_cell, std::vector<uint8_t>& filled, Visitor& visitor)
+{
+    filled.assign(static_cast<size_t>(grid.size()), 0);
+    std::vector<uint8_t> open_sides(static_cast<size_t>(grid.size()));
+    std::vector<int32_t> work;
+    auto fillable = [&](int32_t cell) { return cell != start_cell && cell != end_cell; };
+    for (int32_t i = 0; i < grid.size(); ++i) {
+        open_sides[i] = static_cast<uint8_t>(4 - __builtin_popcount(grid[i].walls()));
+        if (open_sides[i] <= 1 && fillable(i)) work.push_back(i);
+    }
+
+    // A cell is queued once, when its count first drops to one (or starts at
+    // one or zero); a later drop to zero needs no second visit.
+    while (!work.empty()) {
+        int32_t current = work.back();
+        work.pop_back();
+        if (!visitor.fill(current)) return false;
+        filled[current] = 1;
+        Cell cell = grid[current];
+        for (int dir = 0; dir < 4; ++dir) {
+            if (cell.has_wall(dir)) continue;
+            int32_t next = grid.open_neighbour(current, dir);
+            if (filled[next]) continue;
+            if (--open_sides[next] == 1 && fillable(next)) work.push_back(next);
+        }
+        visitor.frontier(work.size());
+    }
+    return true;
+}
+
+template <class Visitor>
+SolveResult run_search(const Grid& grid, int32_t start_cell, int32_t end_cell, SolveStrategy strategy, Visitor& visitor)
+{
+    switch (strategy)
+    {
+        case SolveStrategy::Dial: {
+            BucketQueue<int32_t> queue(grid.max_cost());
+            return search_dijkstra(grid, start_cell, end_cell, queue, visitor);
+        }
+        case SolveStrategy::AStar:
+            return search_astar(grid, start_cell, end_cell, visitor);
+        case SolveStrategy::BFS:
+            return search_bfs(grid, start_cell, end_cell, visitor);
+        case SolveStrategy::BidirectionalBFS:
+            return search_bidirectional(grid, start_cell, end_cell, visitor);
+        case SolveStrategy::DeadEndFill: {
+            std::vector<uint8_t> filled;
+            if (!fill_dead_ends(grid, start_cell, end_cell, filled, visitor)) return {};
+            PrunedVisitor<Visitor> pruned{visitor, filled.data()};
+            RadixHeap<int32_t> queue;
+            return search_dijkstra(grid, start_cell, end_cell, queue, pruned);
+        }
+        default: {
+            RadixHeap<int32_t> queue;
+            return search_dijkstra(grid, start_cell, end_cell, queue, visitor);
+        }
     }
+}
+
+void clear_search_marks(Grid& grid, bool include_path)
+{
+    for (int32_t i = 0; i < grid.size(); ++i) {
+        CellType type = grid[i].type();
+        if (type == CellType::Visited || type == CellType::Frontier || (include_path && type == CellType::Path)) {
+            grid[i].set_type(CellType::Empty);
+            grid.publish(i);
+        }
+    }
+}
 
-    for(auto& row : cells) for(auto& cell : row) {
-        if (cell.type == CellType::Visited || cell.type == CellType::Frontier) {
-            if (cell.type != CellType::Start && cell.type != CellType::End) {
-                cell.type = CellType::Empty;
+// Buffers for one batch search at a time. A cell counts as visited, or as a
+// target, only when its stamp equals the current epoch, so starting a new
+// search is a counter increment; the stamps are cleared once per 2^32
+// searches, when the counter wraps.
+struct BatchScratch
+{
+    explicit BatchScratch(int32_t cells)
+        : visited(static_cast<size_t>(cells), 0), target(static_cast<size_t>(cells), 0),
+          parent(static_cast<size_t>(cells), NO_PARENT), distance(static_cast<size_t>(cells), 0)
+    {
+    }
+
+    uint32_t next_epoch()
+    {
+        if (++epoch == 0) {
+            std::fill(visited.begin(), visited.end(), 0);
+            std::fill(target.begin(), target.end(), 0);
+            epoch = 1;
+        }
+        return epoch;
+    }
+
+    std::vector<uint32_t> visited;
+    std::vector<uint32_t> target;
+    std::vector<uint8_t> parent;     // parent and distance are valid where
+    std::vector<int32_t> distance;   // visited matches the epoch
+    std::vector<int32_t> queue;
+    uint32_t epoch = 0;
+};
+
+// BFS from `start` that stops once every end cell of `group` is discovered;
+// a discovered cell already has its shortest-path parent. Returns the number
+// of cells expanded.
+int64_t search_group(const Grid& grid, BatchScratch& scratch, int32_t start,
+                     const std::vector<PathQuery>& queries, const int32_t* group, size_t group_size)
+{
+    uint32_t epoch = scratch.next_epoch();
+    int64_t remaining = 0;
+    for (size_t k = 0; k < group_size; ++k) {
+        int32_t end = queries[group[k]].end_cell;
+        if (end != NO_CELL && scratch.target[end] != epoch) {
+            scratch.target[end] = epoch;
+            ++remaining;
+        }
+    }
+
+    std::vector<int32_t>& queue = scratch.queue;
+    queue.clear();
+    size_t head = 0;
+    int64_t expanded = 0;
+    auto discover = [&](int32_t cell, uint8_t parent, int32_t distance) {
+        scratch.visited[cell] = epoch;
+        scratch.parent[cell] = parent;
+        scratch.distance[cell] = distance;
+        queue.push_back(cell);
+        if (scratch.target[cell] == epoch) --remaining;
+    };
+
+    discover(start, ROOT, 0);
+    while (remaining > 0 && head < queue.size()) {
+        int32_t current = queue[head++];
+        ++expanded;
+        Cell cell = grid[current];
+        int32_t distance = scratch.distance[current] + 1;
+        for (int dir = 0; dir < 4; ++dir) {
+            if (cell.has_wall(dir)) continue;
+            int32_t next = grid.open_neighbour(current, dir);
+            if (scratch.visited[next] != epoch) discover(next, static_cast<uint8_t>(opposite(dir)), distance);
+        }
+    }
+    return expanded;
+}
+
+const char* strategy_name(SolveStrategy strategy)
+{
+    for (const MazeSolverInfo& info : maze_solver_list()) {
+        if (info.strategy == strategy) return info.name;
+    }
+    return "solve";
+}
+
+int64_t path_cost(const Grid& grid, const std::vector<int32_t>& path)
+{
+    if (!grid.weighted()) return path.empty() ? 0 : static_cast<int64_t>(path.size()) - 1;
+    int64_t cost = 0;
+    for (size_t i = 1; i < path.size(); ++i) cost += grid.cost(path[i]);
+    return cost;
+}
+
+} // namespace
+
+SolveResult solve_maze(const Grid& grid, int32_t start_cell, int32_t end_cell, SolveStrategy strategy)
+{
+    if (start_cell == NO_CELL || end_cell == NO_CELL) return {};
+    PerfTimer timer(PerfPhase::Solve, strategy_name(strategy));
+    HeadlessVisitor visitor;
+    SolveResult result = run_search(grid, start_cell, end_cell, strategy, visitor);
+    result.cost = path_cost(grid, result.path);
+    return result;
+}
+
+SolveResult solve_maze(const Grid& grid, int32_t start_cell, int32_t end_cell, SolveStrategy strategy,
+                       const std::vector<uint8_t>& pruned)
+{
+    if (pruned.size() != static_cast<size_t>(grid.size())) {
+        throw std::invalid_argument("solve_maze: pruned mask needs one entry per cell");
+    }
+    if (start_cell == NO_CELL || end_cell == NO_CELL) return {};
+    PerfTimer timer(PerfPhase::Solve, strategy_name(strategy));
+    HeadlessVisitor headless;
+    PrunedVisitor<HeadlessVisitor> visitor{headless, pruned.data()};
+    SolveResult result = run_search(grid, start_cell, end_cell, strategy, visitor);
+    result.cost = path_cost(grid, result.path);
+    return result;
+}
+
+std::vector<uint8_t> fill_dead_ends(const Grid& grid, int32_t start_cell, int32_t end_cell)
+{
+    std::vector<uint8_t> filled;
+    HeadlessVisitor visitor;
+    fill_dead_ends(grid, start_cell, end_cell, filled, visitor);
+    return filled;
+}
+
+SolveResult solve_maze(Grid& grid, int32_t start_cell, int32_t end_cell, SolveStrategy strategy, std::atomic<bool>* is_running)
+{
+    if (start_cell == NO_CELL || end_cell == NO_CELL) {
+        if (is_running) *is_running = false;
+        return {};
+    }
+
+    PerfTimer timer(PerfPhase::Solve, strategy_name(strategy));
+    clear_search_marks(grid, true);
+    AnimatedVisitor visitor{grid, is_running, {}};
+    SolveResult result = run_search(grid, start_cell, end_cell, strategy, visitor);
+    result.cost = path_cost(grid, result.path);
+    if (is_running) clear_search_marks(grid, false);
+
+    for (auto it = result.path.rbegin(); it != result.path.rend(); ++it) {
+        CellType type = grid[*it].type();
+        if (type != CellType::Start && type != CellType::End) {
+            grid[*it].set_type(CellType::Path);
+            grid.publish(*it);
+        }
+    }
+
+    if (is_running) *is_running = false;
+    return result;
+}
+
+BatchSolveResult solve_batch(const Grid& grid, const std::vector<PathQuery>& queries, bool want_paths)
+{
+    PerfTimer timer(PerfPhase::Solve, "batch");
+    BatchSolveResult result;
+    result.lengths.assign(queries.size(), -1);
+    if (want_paths) result.paths.resize(queries.size());
+
+    // Query indices ordered by start cell; each run of equal starts is a group.
+    std::vector<int32_t> order;
+    order.reserve(queries.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+        if (queries[i].start_cell != NO_CELL && queries[i].end_cell != NO_CELL) order.push_back(static_cast<int32_t>(i));
+    }
+    std::sort(order.begin(), order.end(), [&](int32_t a, int32_t b) {
+        return queries[a].start_cell != queries[b].start_cell ? queries[a].start_cell < queries[b].start_cell : a < b;
+    });
+    std::vector<size_t> group_begin;
+    for (size_t k = 0; k < order.size(); ++k) {
+        if (k == 0 || queries[order[k]].start_cell != queries[order[k - 1]].start_cell) group_begin.push_back(k);
+    }
+    group_begin.push_back(order.size());
+    int64_t groups = static_cast<int64_t>(group_begin.size()) - 1;
+    result.searches = groups;
+
+    // Scratch buffers are handed out per group rather than per thread id,
+    // since threads outside the pool may run tasks too. At most one exists
+    // per task running at once.
+    std::mutex scratch_mutex;
+    std::vector<std::unique_ptr<BatchScratch>> spare;
+    std::atomic<int64_t> expanded{0};
+    default_thread_pool().parallel_for(0, groups, [&](int64_t g) {
+        std::unique_ptr<BatchScratch> scratch;
+        {
+            std::lock_guard<std::mutex> lock(scratch_mutex);
+            if (!spare.empty()) {
+                scratch = std::move(spare.back());
+                spare.pop_back();
             }
         }
+        if (!scratch) scratch = std::make_unique<BatchScratch>(grid.size());
+
+        const int32_t* group = order.data() + group_begin[g];
+        size_t group_size = group_begin[g + 1] - group_begin[g];
+        int32_t start = queries[group[0]].start_cell;
+        int64_t group_expanded = search_group(grid, *scratch, start, queries, group, group_size);
+        expanded.fetch_add(group_expanded, std::memory_order_relaxed);
+        PerfTally tally;
+        tally.visit(group_expanded);
+        for (size_t k = 0; k < group_size; ++k) {
+            int32_t end = queries[group[k]].end_cell;
+            if (scratch->visited[end] != scratch->epoch) continue;
+            result.lengths[group[k]] = scratch->distance[end];
+            if (want_paths) result.paths[group[k]] = trace_path(grid, scratch->parent, end);
+        }
+
+        std::lock_guard<std::mutex> lock(scratch_mutex);
+        spare.push_back(std::move(scratch));
+    });
+    result.expanded = expanded.load();
+    return result;
+}
+
+void dijkstra_solve(Grid& grid, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running)
+{
+    solve_maze(grid, start_cell, end_cell, SolveStrategy::Dijkstra, is_running);
+}
+
+void astar_solve(Grid& grid, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running)
+{
+    solve_maze(grid, start_cell, end_cell, SolveStrategy::AStar, is_running);
+}
+
+void dial_solve(Grid& grid, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running)
+{
+    solve_maze(grid, start_cell, end_cell, SolveStrategy::Dial, is_running);
+}
+
+void dead_end_fill_solve(Grid& grid, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running)
+{
+    solve_maze(grid, start_cell, end_cell, SolveStrategy::DeadEndFill, is_running);
+}
+
+void bfs_solve(Grid& grid, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running)
+{
+    solve_maze(grid, start_cell, end_cell, SolveStrategy::BFS, is_running);
+}
+
+void bidirectional_solve(Grid& grid, int32_t start_cell, int32_t end_cell, std::atomic<bool>* is_running)
+{
+    solve_maze(grid, start_cell, end_cell, SolveStrategy::BidirectionalBFS, is_running);
+}
+
+MappedSolveResult solve_mapped_maze(const MappedMaze& maze, int64_t start_cell, int64_t end_cell)
+{
+    // Same BFS as search_bfs, but over int64 indices and the packed walls of
+    // the mapping. One parent byte per cell is the only O(cells) state.
+    if (start_cell < 0 || start_cell >= maze.size() || end_cell < 0 || end_cell >= maze.size()) {
+        throw std::invalid_argument("solve_mapped_maze: start and end must lie inside the maze");
     }
+    PerfTimer timer(PerfPhase::Solve, "mapped-bfs");
+    PerfTally tally;
+    MappedSolveResult result;
+    std::vector<uint8_t> parent(static_cast<size_t>(maze.size()), NO_PARENT);
+    std::vector<int64_t> queue;
+    size_t head = 0;
 
-    if (current == end_cell) {
-        while(current->parent != nullptr) {
-            current = current->parent;
-            if (current->type != CellType::Start) {
-                current->type = CellType::Path;
-                if (is_running) std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    parent[start_cell] = ROOT;
+    queue.push_back(start_cell);
+    while (head < queue.size()) {
+        int64_t current = queue[head++];
+        compact_queue(queue, head);
+        ++result.expanded;
+        tally.visit();
+        if (current == end_cell) {
+            for (int64_t cell = end_cell; ; cell = maze.open_neighbour(cell, parent[cell])) {
+                result.path.push_back(cell);
+                if (parent[cell] == ROOT) break;
             }
+            std::reverse(result.path.begin(), result.path.end());
+            return result;
         }
+
+        uint8_t walls = maze.walls(current);
+        for (int dir = 0; dir < 4; ++dir) {
+            if (walls & (1u << dir)) continue;
+            int64_t next = maze.open_neighbour(current, dir);
+            // Like load_maze, a passage needs both cells to agree it is open.
+            if (parent[next] != NO_PARENT || maze.has_wall(next, opposite(dir))) continue;
+            parent[next] = static_cast<uint8_t>(opposite(dir));
+            queue.push_back(next);
+        }
+        tally.frontier(queue.size() - head);
     }
+    return result;
+}
 
-    if (is_running) *is_running = false;
+const std::vector<MazeSolverInfo>& maze_solver_list()
+{
+    static const std::vector<MazeSolverInfo> solvers = {
+        {"dijkstra", dijkstra_solve, SolveStrategy::Dijkstra},
+        {"astar", astar_solve, SolveStrategy::AStar},
+        {"dial", dial_solve, SolveStrategy::Dial},
+        {"bfs", bfs_solve, SolveStrategy::BFS},
+        {"bidirectional", bidirectional_solve, SolveStrategy::BidirectionalBFS},
+        {"dead-end", dead_end_fill_solve, SolveStrategy::DeadEndFill},
+    };
+    return solvers;
+}
+
+const MazeSolverInfo* find_maze_solver(const std::string& name)
+{
+    for (const MazeSolverInfo& info : maze_solver_list()) {
+        if (name == info.name) return &info;
+    }
+    return nullptr;
 }
@@ -0,0 +1,149 @@
+#include "maze_stats.hpp"
+#include "bitboard.hpp"
+#include "perf_counters.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+
+namespace {
+
+int open_sides(const Cell& cell)
+{
+    return 4 - __builtin_popcount(cell.walls());
+}
+
+// Cells from `dead_end` up to, not including, the first cell that is not a
+// plain two-way corridor cell.
+int64_t branch_length(const Grid& grid, int32_t dead_end)
+{
+    int64_t length = 0;
+    int32_t previous = NO_CELL;
+    int32_t cell = dead_end;
+    while (true) {
+        ++length;
+        int32_t next = NO_CELL;
+        for (int dir = 0; dir < 4; ++dir) {
+            if (grid[cell].has_wall(dir)) continue;
+            int32_t other = grid.open_neighbour(cell, dir);
+            if (other != previous) {
+                next = other;
+                break;
+            }
+        }
+        if (next == NO_CELL || open_sides(grid[next]) != 2) return length;
+        previous = cell;
+        cell = next;
+    }
+}
+
+std::string format(const char* pattern, ...)
+{
+    char buffer[160];
+    va_list args;
+    va_start(args, pattern);
+    std::vsnprintf(buffer, sizeof buffer, pattern, args);
+    va_end(args);
+    return buffer;
+}
+
+double percent(int64_t part, int64_t whole)
+{
+    return whole > 0 ? 100.0 * static_cast<double>(part) / static_cast<double>(whole) : 0.0;
+}
+
+} // namespace
+
+void MazeStats::merge(const MazeStats& other)
+{
+    cells += other.cells;
+    passages += other.passages;
+    for (int i = 0; i < 5; ++i) degree[i] += other.degree[i];
+    straights += other.straights;
+    turns += other.turns;
+    branch_cells += other.branch_cells;
+}
+
+double MazeStats::average_corridor() const
+{
+    int64_t count = corridors();
+    return count > 0 ? static_cast<double>(passages) / static_cast<double>(count) : 0.0;
+}
+
+double MazeStats::river() const
+{
+    return dead_ends() > 0 ? static_cast<double>(branch_cells) / static_cast<double>(dead_ends()) : 0.0;
+}
+
+double MazeStats::solution_ratio() const
+{
+    return solution_length >= 0 && cells > 0 ? static_cast<double>(solution_length + 1) / static_cast<double>(cells)
+                                              : 0.0;
+}
+
+MazeStats analyse_maze(const Grid& grid, int32_t start, int32_t end, const std::atomic<bool>* is_running)
+{
+    auto cancelled = [is_running] { return is_running && !is_running->load(std::memory_order_relaxed); };
+    PerfTimer timer(PerfPhase::Analyse, "stats");
+    // The cells are split into index ranges that count independently (whole
+    // rows, or whole tiles of a tiled grid); branch walks only read, so each
+    // chunk follows the branches of its own dead ends.
+    constexpr int64_t CHUNK_CELLS = 1 << 18;
+    const int width = grid.width();
+    const int64_t rows_per_chunk = std::max<int64_t>(1, CHUNK_CELLS / width);
+    const int64_t chunks = (grid.height() + rows_per_chunk - 1) / rows_per_chunk;
+    std::vector<MazeStats> partial(static_cast<size_t>(chunks));
+    default_thread_pool().parallel_for(0, chunks, [&](int64_t chunk) {
+        MazeStats& stats = partial[static_cast<size_t>(chunk)];
+        int32_t first = static_cast<int32_t>(chunk * rows_per_chunk * width);
+        int32_t last = static_cast<int32_t>(std::min<int64_t>(grid.height(), (chunk + 1) * rows_per_chunk) * width);
+        const Cell* cells = grid.data();
+        for (int32_t row = first; row < last; row += width) {
+            if (cancelled()) return;
+            for (int32_t i = row; i < row + width; ++i) {
+                stats.add_cell(cells[i].walls());
+                if (open_sides(cells[i]) == 1) stats.branch_cells += branch_length(grid, i);
+            }
+        }
+    });
+
+    MazeStats result;
+    for (const MazeStats& stats : partial) result.merge(stats);
+    if (grid.size() == 0 || cancelled()) return result;
+
+    PassageBitboard board(grid);
+    int32_t source = start != NO_CELL ? start : 0;
+    BfsSummary first = board.sweep(source, end, is_running);
+    if (cancelled()) return result;
+    BfsSummary second = board.sweep(first.farthest, NO_CELL, is_running);
+    result.reached = first.reached;
+    result.diameter = second.max_distance;
+    result.diameter_ends[0] = first.farthest;
+    result.diameter_ends[1] = second.farthest;
+    if (start != NO_CELL && end != NO_CELL) result.solution_length = first.target_distance;
+    return result;
+}
+
+std::vector<std::string> maze_stats_lines(const MazeStats& stats)
+{
+    std::vector<std::string> lines;
+    lines.push_back(format("cells %lld  passages %lld%s", static_cast<long long>(stats.cells),
+                           static_cast<long long>(stats.passages),
+                           stats.reached > 0 ? (stats.perfect() ? "  perfect" : "  not perfect") : ""));
+    lines.push_back(format("dead ends %lld (%.1f%%)  junctions %lld (3-way %lld, 4-way %lld)",
+                           static_cast<long long>(stats.dead_ends()), percent(stats.dead_ends(), stats.cells),
+                           static_cast<long long>(stats.junctions()), static_cast<long long>(stats.degree[3]),
+                           static_cast<long long>(stats.degree[4])));
+    lines.push_back(format("corridors %lld  avg length %.2f  straights %lld  turns %lld",
+                           static_cast<long long>(stats.corridors()), stats.average_corridor(),
+                           static_cast<long long>(stats.straights), static_cast<long long>(stats.turns)));
+    if (stats.reached > 0) {
+        lines.push_back(format("river %.2f  diameter %d", stats.river(), stats.diameter));
+    }
+    if (stats.solution_length >= 0) {
+        lines.push_back(format("solution %d cells (%.2f%% of the maze)", stats.solution_length + 1,
+                               100.0 * stats.solution_ratio()));
+    }
+    return lines;
+}
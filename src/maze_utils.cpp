@@ -1,115 +1,71 @@
 #include "maze_utils.hpp"
 #include <algorithm>
 
-static std::random_device rd;
-std::mt19937 g(rd());
-
-bool is_maze_generated(const std::vector<std::vector<Cell>>& cells)
+bool is_maze_generated(const Grid& grid)
 {
-    for(const auto& row : cells) {
-        for(const auto& cell : row) {
-            if (!cell.walls[0] || !cell.walls[1] || !cell.walls[2] || !cell.walls[3]) {
-                return true;
-            }
+    const Cell* cells = grid.data();
+    for (int32_t i = 0; i < grid.size(); ++i) {
+        if (cells[i].walls() != ALL_WALLS) {
+            return true;
         }
     }
     return false;
 }
 
-void cells_reset(std::vector<std::vector<Cell>>& cells)
+void cells_reset(Grid& grid)
 {
-    for(auto& row : cells) for(auto& cell : row)
-    {
-        cell.visited = false;
-        for(int i=0; i<4; ++i) cell.walls[i] = true;
-        cell.type = CellType::Empty;
-        cell.parent = nullptr;
-    }
+    grid.reset();
 }
 
-void removeWalls(Cell& a, Cell& b)
+void removeWalls(Grid& grid, int32_t a, int32_t b)
 {
-    int x = a.x - b.x;
-    if (x == -1) {
-        a.walls[1] = false;
-        b.walls[3] = false;
-    } 
-    else if (x == 1) {
-        a.walls[3] = false;
-        b.walls[1] = false;
-    }
-
-    int y = a.y - b.y;
-    if (y == -1) {
-        a.walls[2] = false;
-        b.walls[0] = false;
-    }
-    else if (y == 1) {
-        a.walls[0] = false;
-        b.walls[2] = false;
+    for (int dir = 0; dir < 4; ++dir) {
+        if (grid.neighbour(a, dir) == b) {
+            grid[a].set_wall(dir, false);
+            grid[b].set_wall(opposite(dir), false);
+            return;
+        }
     }
 }
 
-std::vector<Cell*> get_neighbours(Cell* current, std::vector<std::vector<Cell>>& cells, bool get_visited)
+NeighbourList get_neighbours(int32_t current, const Grid& grid, bool get_visited)
 {
-    std::vector<Cell*> neighbours;
-    int cx = current->x;
-    int cy = current->y;
-
-    if (cy > 0 && cells[cx][cy-1].visited == get_visited) {
-        neighbours.push_back(&cells[cx][cy-1]);
-    }
-    if (cx < GRID_WIDTH - 1 && cells[cx+1][cy].visited == get_visited) {
-        neighbours.push_back(&cells[cx+1][cy]);
-    }
-    if (cy < GRID_HEIGHT - 1 && cells[cx][cy+1].visited == get_visited) {
-        neighbours.push_back(&cells[cx][cy+1]);
-    }
-    if (cx > 0 && cells[cx-1][cy].visited == get_visited) {
-        neighbours.push_back(&cells[cx-1][cy]);
+    NeighbourList neighbours;
+    int32_t around[4];
+    grid.neighbours(current, around);
+    for (int32_t next : around) {
+        if (next != NO_CELL && grid[next].visited() == get_visited) {
+            neighbours.push(next);
+        }
     }
     return neighbours;
 }
 
-std::vector<Cell*> get_neighbours(Cell* current, std::vector<std::vector<Cell>>& cells)
+NeighbourList get_neighbours(int32_t current, const Grid& grid)
 {
-    std::vector<Cell*> neighbours;
-    int cx = current->x;
-    int cy = current->y;
-
-    if (!current->walls[0] && !cells[cx][cy-1].visited) {
-        neighbours.push_back(&cells[cx][cy-1]);
-    }
-    if (!current->walls[1] && !cells[cx+1][cy].visited) {
-        neighbours.push_back(&cells[cx+1][cy]);
-    }
-    if (!current->walls[2] && !cells[cx][cy+1].visited) {
-        neighbours.push_back(&cells[cx][cy+1]);
-    }
-    if (!current->walls[3] && !cells[cx-1][cy].visited) {
-        neighbours.push_back(&cells[cx-1][cy]);
+    NeighbourList neighbours;
+    for (int dir = 0; dir < 4; ++dir) {
+        if (grid[current].has_wall(dir)) continue;
+        int32_t next = grid.open_neighbour(current, dir);
+        if (!grid[next].visited()) {
+            neighbours.push(next);
+        }
     }
     return neighbours;
 }
 
-void add_neighbours_to_frontier(Cell* cell, std::vector<std::vector<Cell>>& cells, std::vector<Cell*>& frontier)
+void add_neighbours_to_frontier(int32_t cell, Grid& grid, std::vector<int32_t>& frontier, std::vector<bool>& in_frontier, bool mark_cells)
 {
-    int cx = cell->x;
-    int cy = cell->y;
-
-    auto add_if_valid = [&](int x, int y) {
-        if (x >= 0 && x < GRID_WIDTH && y >= 0 && y < GRID_HEIGHT && !cells[x][y].visited) {
-            bool in_frontier = false;
-            for(Cell* f_cell : frontier) if(f_cell == &cells[x][y]) in_frontier = true;
-            if(!in_frontier) {
-                cells[x][y].type = CellType::Frontier;
-                frontier.push_back(&cells[x][y]);
+    int32_t around[4];
+    grid.neighbours(cell, around);
+    for (int32_t next : around) {
+        if (next != NO_CELL && !grid[next].visited() && !in_frontier[next]) {
+            in_frontier[next] = true;
+            if (mark_cells) {
+                grid[next].set_type(CellType::Frontier);
+                grid.publish(next);
             }
+            frontier.push_back(next);
         }
-    };
-
-    add_if_valid(cx, cy - 1);
-    add_if_valid(cx + 1, cy);
-    add_if_valid(cx, cy + 1);
-    add_if_valid(cx - 1, cy);
+    }
 }
@@ -0,0 +1,246 @@
+#include "path_analysis.hpp"
+#include "priority_queues.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <set>
+#include <utility>
+
+namespace {
+
+constexpr uint8_t NO_PARENT = 0xFF;
+constexpr uint8_t ROOT = 4;
+
+// Cost of the cheapest path from every cell to `end_cell`, counting the
+// cells entered after the first; INT32_MAX where the end is unreachable.
+std::vector<int32_t> costs_to(const Grid& grid, int32_t end_cell)
+{
+    std::vector<int32_t> distance(static_cast<size_t>(grid.size()), INT32_MAX);
+    RadixHeap<int32_t> queue;
+    distance[end_cell] = 0;
+    queue.push(0, end_cell);
+    while (!queue.empty()) {
+        std::pair<int32_t, int32_t> top = queue.pop();
+        int32_t current = top.second;
+        if (top.first > distance[current]) continue;
+        // Stepping back from `current` to a neighbour means the path enters `current`.
+        int32_t new_dist = top.first + grid.cost(current);
+        Cell cell = grid[current];
+        for (int dir = 0; dir < 4; ++dir) {
+            if (cell.has_wall(dir)) continue;
+            int32_t next = grid.open_neighbour(current, dir);
+            if (new_dist < distance[next]) {
+                distance[next] = new_dist;
+                queue.push(new_dist, next);
+            }
+        }
+    }
+    return distance;
+}
+
+// A* from a spur cell to the fixed end cell, run many times on one grid.
+// The heuristic is the exact cost to the end in the unblocked maze, found
+// once up front: blocking cells only makes paths dearer, so it stays
+// admissible and consistent, and a spur search walks almost straight to the
+// end unless the blocks force a detour. Blocked cells and the cells seen by
+// the current search are marked with the current epoch, so a new search
+// starts with a counter increment.
+class SpurSearch
+{
+public:
+    SpurSearch(const Grid& grid, int32_t end_cell)
+        : grid_(grid), end_cell_(end_cell), to_end_(costs_to(grid, end_cell)),
+          blocked_(static_cast<size_t>(grid.size()), 0), seen_(static_cast<size_t>(grid.size()), 0),
+          distance_(static_cast<size_t>(grid.size()), 0), parent_(static_cast<size_t>(grid.size()), NO_PARENT)
+    {
+    }
+
+    // Starts a new round of blocks and search marks.
+    void begin()
+    {
+        if (++epoch_ == 0) {
+            std::fill(blocked_.begin(), blocked_.end(), 0);
+            std::fill(seen_.begin(), seen_.end(), 0);
+            epoch_ = 1;
+        }
+    }
+
+    void block(int32_t cell) { blocked_[cell] = epoch_; }
+
+    // Cheapest path from `spur` to the end cell that avoids the blocked cells
+    // and does not leave `spur` in a direction set in `blocked_dirs`. Gives
+    // up, returning an empty path, once no path can cost `limit` or less.
+    // `cost` receives the cost of the cells entered after `spur`.
+    std::vector<int32_t> run(int32_t spur, uint8_t blocked_dirs, int64_t limit, int64_t& cost, int64_t& expanded)
+    {
+        std::vector<int32_t> path;
+        const int32_t bound = static_cast<int32_t>(std::min<int64_t>(limit, INT32_MAX));
+        queue_.clear();
+        seen_[spur] = epoch_;
+        distance_[spur] = 0;
+        parent_[spur] = ROOT;
+        if (to_end_[spur] == INT32_MAX) return path;
+        queue_.push(to_end_[spur], spur);
+        while (!queue_.empty()) {
+            // The heuristic is consistent, so keys leave the queue in order,
+            // as the radix heap requires.
+            std::pair<int32_t, int32_t> top = queue_.pop();
+            int32_t current = top.second;
+            int32_t g = distance_[current];
+            if (top.first > g + to_end_[current]) continue;
+            if (top.first > bound) break;
+            ++expanded;
+            if (current == end_cell_) {
+                cost = g;
+                for (int32_t cell = current; ; cell = grid_.open_neighbour(cell, parent_[cell])) {
+                    path.push_back(cell);
+                    if (parent_[cell] == ROOT) break;
+                }
+                std::reverse(path.begin(), path.end());
+                return path;
+            }
+
+            Cell cell = grid_[current];
+            for (int dir = 0; dir < 4; ++dir) {
+                if (cell.has_wall(dir)) continue;
+                if (current == spur && (blocked_dirs >> dir) & 1) continue;
+                int32_t next = grid_.open_neighbour(current, dir);
+                if (blocked_[next] == epoch_ || to_end_[next] == INT32_MAX) continue;
+                int32_t new_g = g + grid_.cost(next);
+                if (seen_[next] == epoch_ && new_g >= distance_[next]) continue;
+                seen_[next] = epoch_;
+                distance_[next] = new_g;
+                parent_[next] = static_cast<uint8_t>(opposite(dir));
+                queue_.push(new_g + to_end_[next], next);
+            }
+        }
+        return path;
+    }
+
+private:
+    const Grid& grid_;
+    int32_t end_cell_;
+    std::vector<int32_t> to_end_;
+    std::vector<uint32_t> blocked_;
+    std::vector<uint32_t> seen_;
+    std::vector<int32_t> distance_;  // valid where seen_ matches the epoch
+    std::vector<uint8_t> parent_;
+    RadixHeap<int32_t> queue_;
+    uint32_t epoch_ = 0;
+};
+
+// Direction of the open wall from `cell` to its neighbour `next`.
+int direction_to(const Grid& grid, int32_t cell, int32_t next)
+{
+    for (int dir = 0; dir < 4; ++dir) {
+        if (!grid[cell].has_wall(dir) && grid.open_neighbour(cell, dir) == next) return dir;
+    }
+    return -1;
+}
+
+} // namespace
+
+std::vector<SolveResult> k_shortest_paths(const Grid& grid, int32_t start_cell, int32_t end_cell, int k)
+{
+    std::vector<SolveResult> found;
+    if (k <= 0 || start_cell == NO_CELL || end_cell == NO_CELL) return found;
+    found.push_back(solve_maze(grid, start_cell, end_cell, SolveStrategy::Dijkstra));
+    if (found.back().path.empty()) {
+        found.clear();
+        return found;
+    }
+
+    // Candidates ordered by cost, then path, which also drops duplicates.
+    std::set<std::pair<int64_t, std::vector<int32_t>>> candidates;
+    SpurSearch search(grid, end_cell);
+    int64_t expanded = 0;
+    while (static_cast<int>(found.size()) < k) {
+        const std::vector<int32_t> last = found.back().path;
+        const size_t wanted = static_cast<size_t>(k) - found.size();
+
+        // Paths found so far that share the root last[0..i]; the set only
+        // shrinks as i grows, so each path is compared once per cell.
+        std::vector<size_t> sharing(found.size());
+        for (size_t p = 0; p < found.size(); ++p) sharing[p] = p;
+        int64_t root_cost = 0;
+        for (size_t i = 0; i + 1 < last.size(); ++i) {
+            const int32_t spur = last[i];
+            uint8_t blocked_dirs = 0;
+            size_t kept = 0;
+            for (size_t p : sharing) {
+                const std::vector<int32_t>& path = found[p].path;
+                if (path.size() <= i || path[i] != spur) continue;
+                sharing[kept++] = p;
+                if (path.size() > i + 1) blocked_dirs |= static_cast<uint8_t>(1u << direction_to(grid, spur, path[i + 1]));
+            }
+            sharing.resize(kept);
+
+            search.begin();
+            for (size_t j = 0; j < i; ++j) search.block(last[j]);
+            // With the set full only a strictly cheaper path can displace a candidate.
+            int64_t limit = INT64_MAX;
+            if (candidates.size() >= wanted) limit = candidates.rbegin()->first - root_cost - 1;
+            int64_t spur_cost = 0;
+            std::vector<int32_t> spur_path = search.run(spur, blocked_dirs, limit, spur_cost, expanded);
+            if (!spur_path.empty()) {
+                std::vector<int32_t> path(last.begin(), last.begin() + static_cast<std::ptrdiff_t>(i));
+                path.insert(path.end(), spur_path.begin(), spur_path.end());
+                candidates.emplace(root_cost + spur_cost, std::move(path));
+                // Later rounds take at most `wanted` of them.
+                if (candidates.size() > wanted) candidates.erase(std::prev(candidates.end()));
+            }
+            root_cost += grid.cost(last[i + 1]);
+        }
+
+        if (candidates.empty()) break;
+        auto cheapest = candidates.extract(candidates.begin());
+        SolveResult next;
+        next.cost = cheapest.value().first;
+        next.path = std::move(cheapest.value().second);
+        next.expanded = expanded;
+        found.push_back(std::move(next));
+        expanded = 0;
+    }
+    return found;
+}
+
+PathCount count_shortest_paths(const Grid& grid, int32_t start_cell, int32_t end_cell)
+{
+    PathCount result;
+    if (start_cell == NO_CELL || end_cell == NO_CELL) return result;
+    std::vector<int32_t> distance(static_cast<size_t>(grid.size()), INT32_MAX);
+    std::vector<uint64_t> count(static_cast<size_t>(grid.size()), 0);
+    RadixHeap<int32_t> queue;
+
+    distance[start_cell] = 0;
+    count[start_cell] = 1;
+    queue.push(0, start_cell);
+    while (!queue.empty()) {
+        std::pair<int32_t, int32_t> top = queue.pop();
+        int32_t current = top.second;
+        if (top.first > distance[current]) continue;
+        ++result.expanded;
+        if (current == end_cell) {
+            result.cost = top.first;
+            result.count = count[current];
+            result.saturated = count[current] == UINT64_MAX;
+            return result;
+        }
+
+        Cell cell = grid[current];
+        for (int dir = 0; dir < 4; ++dir) {
+            if (cell.has_wall(dir)) continue;
+            int32_t next = grid.open_neighbour(current, dir);
+            int32_t new_dist = top.first + grid.cost(next);
+            if (new_dist < distance[next]) {
+                distance[next] = new_dist;
+                count[next] = count[current];
+                queue.push(new_dist, next);
+            } else if (new_dist == distance[next]) {
+                uint64_t sum;
+                count[next] = __builtin_add_overflow(count[next], count[current], &sum) ? UINT64_MAX : sum;
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,225 @@
+#include "perf_counters.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+constexpr int SLOT_COUNT = 64;
+// Threads that find every slot taken share the last one; the atomics keep
+// its counts right, they just contend.
+constexpr int SHARED_SLOT = SLOT_COUNT - 1;
+
+struct alignas(64) Slot
+{
+    std::atomic<bool> claimed{false};
+    std::atomic<int64_t> cells_visited{0};
+    std::atomic<int64_t> frontier_peak{0};
+    std::atomic<int64_t> allocations{0};
+    std::atomic<int64_t> allocated_bytes{0};
+    std::atomic<int64_t> phase_ns[PERF_PHASE_COUNT];
+    std::atomic<int64_t> phase_runs[PERF_PHASE_COUNT];
+};
+
+// Zero-initialised before any code runs, so operator new may use them from
+// the first allocation on, and never allocates itself.
+Slot slots[SLOT_COUNT];
+
+// A finished thread gives its slot back but leaves the counts in it; the
+// next thread to claim the slot keeps adding to them, so the sums never
+// lose what earlier threads did.
+struct SlotHandle
+{
+    Slot* slot = nullptr;
+
+    ~SlotHandle()
+    {
+        if (slot && slot != &slots[SHARED_SLOT]) slot->claimed.store(false, std::memory_order_release);
+    }
+};
+
+thread_local SlotHandle handle;
+
+Slot& thread_slot()
+{
+    if (handle.slot) return *handle.slot;
+    for (int i = 0; i < SHARED_SLOT; ++i) {
+        bool expected = false;
+        if (!slots[i].claimed.load(std::memory_order_relaxed)
+            && slots[i].claimed.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            handle.slot = &slots[i];
+            return slots[i];
+        }
+    }
+    handle.slot = &slots[SHARED_SLOT];
+    return slots[SHARED_SLOT];
+}
+
+void raise_to(std::atomic<int64_t>& peak, int64_t value)
+{
+    int64_t current = peak.load(std::memory_order_relaxed);
+    while (value > current && !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+struct TraceEvent
+{
+    const char* name;
+    PerfPhase phase;
+    int thread;
+    int64_t begin_ns;
+    int64_t duration_ns;
+};
+
+std::atomic<bool> tracing{false};
+std::mutex trace_mutex;
+std::vector<TraceEvent> trace_events;
+std::chrono::steady_clock::time_point trace_origin;
+
+int64_t nanoseconds(std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+} // namespace
+
+const char* perf_phase_name(PerfPhase phase)
+{
+    switch (phase)
+    {
+        case PerfPhase::Generate: return "generate";
+        case PerfPhase::Solve: return "solve";
+        case PerfPhase::Analyse: return "analyse";
+        default: return "render";
+    }
+}
+
+PerfSnapshot perf_snapshot()
+{
+    PerfSnapshot snapshot;
+    for (const Slot& slot : slots) {
+        snapshot.cells_visited += slot.cells_visited.load(std::memory_order_relaxed);
+        snapshot.frontier_peak = std::max(snapshot.frontier_peak, slot.frontier_peak.load(std::memory_order_relaxed));
+        snapshot.allocations += slot.allocations.load(std::memory_order_relaxed);
+        snapshot.allocated_bytes += slot.allocated_bytes.load(std::memory_order_relaxed);
+        for (int phase = 0; phase < PERF_PHASE_COUNT; ++phase) {
+            snapshot.phase_ns[phase] += slot.phase_ns[phase].load(std::memory_order_relaxed);
+            snapshot.phase_runs[phase] += slot.phase_runs[phase].load(std::memory_order_relaxed);
+        }
+    }
+    return snapshot;
+}
+
+void perf_reset_peak()
+{
+    for (Slot& slot : slots) slot.frontier_peak.store(0, std::memory_order_relaxed);
+}
+
+void PerfTally::flush()
+{
+    Slot& slot = thread_slot();
+    if (pending_ > 0) slot.cells_visited.fetch_add(pending_, std::memory_order_relaxed);
+    // The slot already holds at least the peak flushed last time.
+    if (peak_ > flushed_peak_) {
+        raise_to(slot.frontier_peak, peak_);
+        flushed_peak_ = peak_;
+    }
+    pending_ = 0;
+}
+
+PerfTimer::PerfTimer(PerfPhase phase, const char* name)
+    : phase_(phase), name_(name), begin_(std::chrono::steady_clock::now())
+{
+}
+
+PerfTimer::~PerfTimer()
+{
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    Slot& slot = thread_slot();
+    int index = static_cast<int>(phase_);
+    slot.phase_ns[index].fetch_add(nanoseconds(end - begin_), std::memory_order_relaxed);
+    slot.phase_runs[index].fetch_add(1, std::memory_order_relaxed);
+    if (!tracing.load(std::memory_order_relaxed)) return;
+
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    if (begin_ < trace_origin) return;
+    trace_events.push_back({name_, phase_, static_cast<int>(&slot - slots), nanoseconds(begin_ - trace_origin),
+                            nanoseconds(end - begin_)});
+}
+
+void perf_trace_start()
+{
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    trace_events.clear();
+    trace_origin = std::chrono::steady_clock::now();
+    tracing.store(true, std::memory_order_relaxed);
+}
+
+void perf_trace_stop()
+{
+    tracing.store(false, std::memory_order_relaxed);
+}
+
+bool perf_tracing()
+{
+    return tracing.load(std::memory_order_relaxed);
+}
+
+size_t perf_trace_size()
+{
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    return trace_events.size();
+}
+
+void perf_write_chrome_trace(const std::string& path)
+{
+    std::vector<TraceEvent> events;
+    {
+        std::lock_guard<std::mutex> lock(trace_mutex);
+        events = trace_events;
+    }
+
+    std::ofstream out(path);
+    if (!out) throw std::runtime_error(path + ": cannot open for writing");
+    // Complete ("X") events in microseconds; one track per counter slot.
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    for (size_t i = 0; i < events.size(); ++i) {
+        const TraceEvent& event = events[i];
+        char line[256];
+        std::snprintf(line, sizeof(line),
+                      "{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": 1, \"tid\": %d}%s\n",
+                      event.name, perf_phase_name(event.phase), event.begin_ns / 1e3, event.duration_ns / 1e3,
+                      event.thread, i + 1 < events.size() ? "," : "");
+        out << line;
+    }
+    out << "]}\n";
+    if (!out) throw std::runtime_error(path + ": write failed");
+}
+
+// Every allocation in a program linked with the core is counted in the
+// calling thread's slot.
+void* operator new(size_t size)
+{
+    Slot& slot = thread_slot();
+    slot.allocations.fetch_add(1, std::memory_order_relaxed);
+    slot.allocated_bytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
@@ -0,0 +1,107 @@
+#include "terrain.hpp"
+#include "rng.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Uniform value in [0, 1) attached to lattice point (x, y).
+double lattice_value(uint64_t seed, int64_t x, int64_t y)
+{
+    uint64_t h = mix64(seed ^ mix64(static_cast<uint64_t>(x) * 0x9E3779B97F4A7C15ull + static_cast<uint64_t>(y)));
+    return static_cast<double>(h >> 11) * 0x1.0p-53;
+}
+
+// Value noise: lattice values `spacing` cells apart, blended with a
+// smoothstep so there are no visible creases along the lattice lines.
+double value_noise(uint64_t seed, int x, int y, double spacing)
+{
+    double fx = x / spacing;
+    double fy = y / spacing;
+    int64_t x0 = static_cast<int64_t>(std::floor(fx));
+    int64_t y0 = static_cast<int64_t>(std::floor(fy));
+    double tx = fx - x0;
+    double ty = fy - y0;
+    tx = tx * tx * (3.0 - 2.0 * tx);
+    ty = ty * ty * (3.0 - 2.0 * ty);
+    double top = lattice_value(seed, x0, y0) + tx * (lattice_value(seed, x0 + 1, y0) - lattice_value(seed, x0, y0));
+    double bottom = lattice_value(seed, x0, y0 + 1)
+                    + tx * (lattice_value(seed, x0 + 1, y0 + 1) - lattice_value(seed, x0, y0 + 1));
+    return top + ty * (bottom - top);
+}
+
+// Three octaves, each half the spacing and half the weight of the last,
+// normalised back to [0, 1).
+double fractal_noise(uint64_t seed, int x, int y, double spacing)
+{
+    double sum = 0.0;
+    double weight = 1.0;
+    double total = 0.0;
+    for (int octave = 0; octave < 3; ++octave) {
+        sum += weight * value_noise(seed + static_cast<uint64_t>(octave), x, y, spacing);
+        total += weight;
+        weight *= 0.5;
+        spacing = std::max(1.0, spacing * 0.5);
+    }
+    return sum / total;
+}
+
+double feature_spacing(const Grid& grid, double fraction)
+{
+    return std::max(4.0, std::min(grid.width(), grid.height()) * fraction);
+}
+
+// Fills the cost layer row by row on the default thread pool; every cell
+// depends only on the seed and its coordinates.
+template <class CostOf>
+void fill_costs(Grid& grid, CostOf cost_of)
+{
+    std::vector<uint8_t> costs(static_cast<size_t>(grid.size()));
+    const int width = grid.width();
+    default_thread_pool().parallel_for(0, grid.height(), [&](int64_t y) {
+        for (int x = 0; x < width; ++x) costs[grid.index(x, static_cast<int>(y))] = cost_of(x, static_cast<int>(y));
+    }, 16);
+    grid.set_costs(std::move(costs));
+}
+
+} // namespace
+
+void fill_noise_costs(Grid& grid, uint64_t seed, int max_cost)
+{
+    max_cost = std::clamp(max_cost, 1, 255);
+    double spacing = feature_spacing(grid, 1.0 / 8);
+    fill_costs(grid, [&](int x, int y) {
+        int level = static_cast<int>(fractal_noise(seed, x, y, spacing) * max_cost);
+        return static_cast<uint8_t>(1 + std::min(level, max_cost - 1));
+    });
+}
+
+void fill_swamp_costs(Grid& grid, uint64_t seed)
+{
+    double spacing = feature_spacing(grid, 1.0 / 5);
+    fill_costs(grid, [&](int x, int y) {
+        double level = fractal_noise(seed, x, y, spacing);
+        if (level > 0.68) return WATER_COST;
+        if (level > 0.56) return MUD_COST;
+        return uint8_t{1};
+    });
+}
+
+const std::vector<TerrainInfo>& terrain_list()
+{
+    static const std::vector<TerrainInfo> terrains = {
+        {"noise", [](Grid& grid, uint64_t seed) { fill_noise_costs(grid, seed); }},
+        {"swamp", fill_swamp_costs},
+    };
+    return terrains;
+}
+
+const TerrainInfo* find_terrain(const std::string& name)
+{
+    for (const TerrainInfo& info : terrain_list()) {
+        if (name == info.name) return &info;
+    }
+    return nullptr;
+}
@@ -0,0 +1,136 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace {
+
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local int current_index = -1;
+
+std::atomic<int> default_thread_count{0};
+
+} // namespace
+
+ThreadPool::ThreadPool(int thread_count)
+{
+    if (thread_count <= 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (int i = 0; i < thread_count; ++i) {
+        queues_.push_back(std::make_unique<TaskQueue>());
+    }
+    for (int i = 0; i < thread_count; ++i) {
+        threads_.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& thread : threads_) thread.join();
+}
+
+int ThreadPool::current_worker() const
+{
+    return current_pool == this ? current_index : -1;
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    int self = current_worker();
+    size_t target = self >= 0 ? static_cast<size_t>(self) : next_queue_.fetch_add(1) % queues_.size();
+    {
+        std::lock_guard<std::mutex> lock(queues_[target]->mutex);
+        queues_[target]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        queued_.fetch_add(1);
+    }
+    wake_.notify_one();
+}
+
+bool ThreadPool::try_run_task(int self)
+{
+    std::function<void()> task;
+    if (self >= 0) {
+        TaskQueue& own = *queues_[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+        }
+    }
+    if (!task) {
+        size_t count = queues_.size();
+        size_t first = self >= 0 ? static_cast<size_t>(self) + 1 : 0;
+        for (size_t k = 0; k < count && !task; ++k) {
+            TaskQueue& victim = *queues_[(first + k) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+            }
+        }
+    }
+    if (!task) return false;
+
+    queued_.fetch_sub(1);
+    task();
+    return true;
+}
+
+void ThreadPool::worker_loop(int index)
+{
+    current_pool = this;
+    current_index = index;
+    while (true) {
+        if (try_run_task(index)) continue;
+
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_.wait(lock, [this] { return stopping_ || queued_.load() > 0; });
+        if (stopping_ && queued_.load() == 0) return;
+    }
+}
+
+void ThreadPool::parallel_for(int64_t begin, int64_t end, const std::function<void(int64_t)>& body, int64_t grain)
+{
+    if (end <= begin) return;
+    grain = std::max<int64_t>(1, grain);
+    int64_t chunks = (end - begin + grain - 1) / grain;
+    if (chunks == 1) {
+        for (int64_t i = begin; i < end; ++i) body(i);
+        return;
+    }
+
+    std::atomic<int64_t> remaining{chunks};
+    for (int64_t chunk = 0; chunk < chunks; ++chunk) {
+        submit([&, chunk] {
+            int64_t lo = begin + chunk * grain;
+            int64_t hi = std::min(end, lo + grain);
+            for (int64_t i = lo; i < hi; ++i) body(i);
+            remaining.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    // Help out instead of blocking, so nested loops and small pools progress.
+    int self = current_worker();
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (!try_run_task(self)) std::this_thread::yield();
+    }
+}
+
+ThreadPool& default_thread_pool()
+{
+    static ThreadPool pool(default_thread_count.load());
+    return pool;
+}
+
+void set_default_thread_count(int thread_count)
+{
+    default_thread_count = thread_count;
+}
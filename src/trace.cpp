@@ -0,0 +1,113 @@
+#include "trace.hpp"
+
+#include <algorithm>
+
+namespace {
+
+void put_varint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+uint64_t get_varint(const uint8_t* data, size_t& offset)
+{
+    uint64_t value = 0;
+    int shift = 0;
+    while (data[offset] & 0x80) {
+        value |= static_cast<uint64_t>(data[offset++] & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= static_cast<uint64_t>(data[offset++]) << shift;
+    return value;
+}
+
+uint64_t zigzag(int64_t value) { return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63); }
+int64_t unzigzag(uint64_t value) { return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1); }
+
+} // namespace
+
+Trace::Trace(const Grid& initial, int64_t keyframe_interval, GridSnapshots* snapshots)
+    : snapshots_(snapshots),
+      interval_(keyframe_interval > 0 ? keyframe_interval : std::max<int64_t>(1024, initial.size()))
+{
+    auto first = std::make_shared<GridSnapshot>(GridSnapshot{0, std::vector<Cell>(initial.data(), initial.data() + initial.size())});
+    keyframes_.push_back({0, 0, std::move(first)});
+    if (!snapshots_) {
+        head_ = initial;
+        head_.set_event_sink(nullptr);
+    }
+}
+
+void Trace::add_keyframe()
+{
+    if (!snapshots_) {
+        auto copy = std::make_shared<GridSnapshot>(GridSnapshot{event_count_, std::vector<Cell>(head_.data(), head_.data() + head_.size())});
+        keyframes_.push_back({bytes_.size(), previous_cell_, std::move(copy)});
+        return;
+    }
+    // A snapshot taken early, for a later boundary, waits in pending_.
+    if (!pending_ || pending_->events < event_count_) pending_ = snapshots_->take();
+    if (pending_ && pending_->events == event_count_) {
+        keyframes_.push_back({bytes_.size(), previous_cell_, std::move(pending_)});
+        pending_.reset();
+    }
+}
+
+void Trace::publish(const CellEvent& event)
+{
+    if (event_count_ > 0 && event_count_ % interval_ == 0) add_keyframe();
+
+    // The low bit of the header flags a whole-grid event, which has no cell.
+    if (event.cell == NO_CELL) {
+        put_varint(bytes_, 1);
+        std::fill(head_.data(), head_.data() + head_.size(), event.state);
+    } else {
+        put_varint(bytes_, zigzag(static_cast<int64_t>(event.cell) - previous_cell_) << 1);
+        previous_cell_ = event.cell;
+        if (!snapshots_) head_[event.cell] = event.state;
+    }
+    bytes_.push_back(event.state.bits);
+    ++event_count_;
+}
+
+CellEvent TracePlayer::decode_next()
+{
+    const uint8_t* data = trace_->bytes_.data();
+    uint64_t header = get_varint(data, offset_);
+    CellEvent event;
+    if (header & 1) {
+        event.cell = NO_CELL;
+    } else {
+        previous_cell_ = static_cast<int32_t>(previous_cell_ + unzigzag(header >> 1));
+        event.cell = previous_cell_;
+    }
+    event.state.bits = data[offset_++];
+    ++position_;
+    return event;
+}
+
+void TracePlayer::seek(Grid& grid, int64_t target)
+{
+    target = std::clamp<int64_t>(target, 0, trace_->size());
+    if (target < position_ || target - position_ > trace_->interval_) {
+        // The last keyframe at or before target. The keyframe for a boundary
+        // only exists once an event follows it, and adopted snapshots may
+        // have gaps, so this is a search rather than target / interval.
+        const std::vector<Trace::Keyframe>& keyframes = trace_->keyframes_;
+        auto after = std::upper_bound(keyframes.begin(), keyframes.end(), target,
+                                      [](int64_t events, const Trace::Keyframe& keyframe) { return events < keyframe.snapshot->events; });
+        const Trace::Keyframe& keyframe = *(after - 1);
+        if (target < position_ || keyframe.snapshot->events > position_) {
+            const std::vector<Cell>& cells = keyframe.snapshot->cells;
+            std::copy(cells.begin(), cells.end(), grid.data());
+            position_ = keyframe.snapshot->events;
+            offset_ = keyframe.offset;
+            previous_cell_ = keyframe.previous_cell;
+        }
+    }
+    step(grid, target - position_, [](int32_t) {});
+}
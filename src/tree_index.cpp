@@ -0,0 +1,116 @@
+#include "tree_index.hpp"
+#include "thread_pool.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+MazeTreeIndex::MazeTreeIndex(const Grid& grid, int32_t root)
+    : parent_(static_cast<size_t>(grid.size())), first_(static_cast<size_t>(grid.size()), -1), root_(root)
+{
+    if (root < 0 || root >= grid.size()) {
+        throw std::invalid_argument("tree index root lies outside the grid");
+    }
+
+    // Depth-first walk that records the Euler tour: a cell's entry is
+    // appended when it is entered and again after each child returns.
+    size_t count = parent_.size();
+    euler_.reserve(2 * count - 1);
+    std::vector<std::pair<int32_t, int>> stack;
+    parent_[root] = root;
+    first_[root] = 0;
+    euler_.push_back(entry(0, root));
+    stack.push_back({root, 0});
+    int64_t passages = 0;
+    while (!stack.empty()) {
+        int32_t cell = stack.back().first;
+        int dir = stack.back().second++;
+        int32_t depth = static_cast<int32_t>(stack.size()) - 1;
+        if (dir == 4) {
+            stack.pop_back();
+            if (!stack.empty()) euler_.push_back(entry(depth - 1, parent_[cell]));
+            continue;
+        }
+        if (grid[cell].has_wall(dir)) continue;
+
+        int32_t child = grid.open_neighbour(cell, dir);
+        ++passages;
+        if (child == parent_[cell]) continue;
+        if (first_[child] >= 0) {
+            throw std::invalid_argument("maze has a loop; the tree index needs a perfect maze");
+        }
+        parent_[child] = cell;
+        first_[child] = static_cast<int32_t>(euler_.size());
+        euler_.push_back(entry(depth + 1, child));
+        stack.push_back({child, 0});
+    }
+
+    // Every passage was seen from both sides.
+    if (euler_.size() != 2 * count - 1 || passages != 2 * (static_cast<int64_t>(count) - 1)) {
+        throw std::invalid_argument("maze is not connected; the tree index needs a perfect maze");
+    }
+
+    blocks_ = (euler_.size() + BLOCK - 1) / BLOCK;
+    int levels = 1;
+    while ((size_t{1} << levels) <= blocks_) ++levels;
+    table_.resize(static_cast<size_t>(levels) * blocks_);
+    for (size_t i = 0; i < blocks_; ++i) {
+        table_[i] = scan(i * BLOCK, std::min(euler_.size(), (i + 1) * BLOCK));
+    }
+    for (int level = 1; level < levels; ++level) {
+        const uint64_t* below = &table_[static_cast<size_t>(level - 1) * blocks_];
+        uint64_t* row = &table_[static_cast<size_t>(level) * blocks_];
+        size_t half = size_t{1} << (level - 1);
+        for (size_t i = 0; i + 2 * half <= blocks_; ++i) row[i] = std::min(below[i], below[i + half]);
+    }
+}
+
+uint64_t MazeTreeIndex::scan(size_t begin, size_t end) const
+{
+    uint64_t best = UINT64_MAX;
+    for (size_t i = begin; i < end; ++i) best = std::min(best, euler_[i]);
+    return best;
+}
+
+uint64_t MazeTreeIndex::tour_min(int32_t a, int32_t b) const
+{
+    size_t left = static_cast<size_t>(first_[a]);
+    size_t right = static_cast<size_t>(first_[b]);
+    if (left > right) std::swap(left, right);
+    size_t left_block = left / BLOCK;
+    size_t right_block = right / BLOCK;
+    if (left_block == right_block) return scan(left, right + 1);
+
+    uint64_t best = std::min(scan(left, (left_block + 1) * BLOCK), scan(right_block * BLOCK, right + 1));
+    size_t inner = right_block - left_block - 1;
+    if (inner > 0) {
+        int level = 63 - __builtin_clzll(inner);
+        const uint64_t* row = &table_[static_cast<size_t>(level) * blocks_];
+        best = std::min({best, row[left_block + 1], row[right_block - (size_t{1} << level)]});
+    }
+    return best;
+}
+
+std::vector<int32_t> MazeTreeIndex::path(int32_t a, int32_t b) const
+{
+    int32_t meet = lca(a, b);
+    std::vector<int32_t> result;
+    result.reserve(static_cast<size_t>(distance(a, b)) + 1);
+    for (int32_t cell = a; cell != meet; cell = parent_[cell]) result.push_back(cell);
+    result.push_back(meet);
+    size_t down_from = result.size();
+    for (int32_t cell = b; cell != meet; cell = parent_[cell]) result.push_back(cell);
+    std::reverse(result.begin() + static_cast<std::ptrdiff_t>(down_from), result.end());
+    return result;
+}
+
+void MazeTreeIndex::distances(const int32_t* starts, const int32_t* ends, int32_t* out, size_t count) const
+{
+    constexpr int64_t CHUNK = 1 << 14;
+    int64_t chunks = (static_cast<int64_t>(count) + CHUNK - 1) / CHUNK;
+    default_thread_pool().parallel_for(0, chunks, [&](int64_t chunk) {
+        size_t first = static_cast<size_t>(chunk * CHUNK);
+        size_t last = std::min(count, first + static_cast<size_t>(CHUNK));
+        for (size_t i = first; i < last; ++i) out[i] = distance(starts[i], ends[i]);
+    });
+}
@@ -0,0 +1,135 @@
+// Regression checks for reading damaged .maze files, run by `make check`.
+#include "maze_file.hpp"
+#include "maze_solvers.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const char* what)
+{
+    if (!condition) {
+        std::printf("FAIL %s\n", what);
+        ++failures;
+    }
+}
+
+const char* const PATH = "obj/tests/maze_file_test.maze";
+
+// Saves a closed 4x4 grid and returns the file's bytes.
+std::vector<uint8_t> saved_bytes()
+{
+    save_maze(Grid(4, 4), PATH, 1, "test");
+    std::vector<uint8_t> bytes;
+    if (std::FILE* file = std::fopen(PATH, "rb")) {
+        int c;
+        while ((c = std::fgetc(file)) != EOF) bytes.push_back(static_cast<uint8_t>(c));
+        std::fclose(file);
+    }
+    return bytes;
+}
+
+void write_bytes(const std::vector<uint8_t>& bytes)
+{
+    std::FILE* file = std::fopen(PATH, "wb");
+    std::fwrite(bytes.data(), 1, bytes.size(), file);
+    std::fclose(file);
+}
+
+bool opens()
+{
+    try {
+        MappedMaze maze(PATH);
+        return true;
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+}
+
+// A header_size past the end of the file must be rejected, not subtracted
+// from the file size.
+void header_larger_than_file()
+{
+    std::vector<uint8_t> bytes = saved_bytes();
+    expect(bytes.size() == sizeof(MazeFileHeader) + 8, "4x4 file is a header and 8 row bytes");
+    write_bytes(bytes);
+    expect(opens(), "intact file opens");
+
+    uint16_t header_size = 4096;
+    std::memcpy(bytes.data() + offsetof(MazeFileHeader, header_size), &header_size, sizeof(header_size));
+    write_bytes(bytes);
+    expect(!opens(), "header_size beyond the file is rejected");
+}
+
+// A file with every wall open, the border included, must not let a search
+// or a loaded Grid step off the maze.
+void open_border()
+{
+    std::vector<uint8_t> bytes = saved_bytes();
+    std::fill(bytes.begin() + sizeof(MazeFileHeader), bytes.end(), 0);
+    write_bytes(bytes);
+
+    MappedMaze maze(PATH);
+    expect(maze.has_wall(0, DIR_TOP) && maze.has_wall(0, DIR_LEFT), "corner reads its border walls closed");
+    expect(maze.has_wall(15, DIR_RIGHT) && maze.has_wall(15, DIR_BOTTOM), "far corner reads its border walls closed");
+    MappedSolveResult result = solve_mapped_maze(maze, 0, 15);
+    expect(result.path.size() == 7 && result.expanded <= 16, "search stays inside the open maze");
+
+    Grid grid = load_maze(PATH);
+    bool closed = true;
+    for (int i = 0; i < 4; ++i) {
+        closed = closed && grid.at(i, 0).has_wall(DIR_TOP) && grid.at(i, 3).has_wall(DIR_BOTTOM)
+                 && grid.at(0, i).has_wall(DIR_LEFT) && grid.at(3, i).has_wall(DIR_RIGHT);
+    }
+    expect(closed, "loaded grid has its border walls closed");
+}
+
+// A wall open on one side only stays closed, in a search and in a Grid.
+void one_sided_wall()
+{
+    std::vector<uint8_t> bytes = saved_bytes();
+    bytes[sizeof(MazeFileHeader)] &= static_cast<uint8_t>(~(1u << DIR_RIGHT));  // cell 0 only
+    write_bytes(bytes);
+
+    MappedMaze maze(PATH);
+    expect(solve_mapped_maze(maze, 0, 1).path.empty(), "search does not cross a one-sided wall");
+    expect(solve_mapped_maze(maze, 1, 0).path.empty(), "nor the other way");
+    Grid grid = load_maze(PATH);
+    expect(grid.at(0, 0).has_wall(DIR_RIGHT) && grid.at(1, 0).has_wall(DIR_LEFT), "loaded grid keeps the wall");
+}
+
+void endpoints_outside()
+{
+    write_bytes(saved_bytes());
+    MappedMaze maze(PATH);
+    for (int64_t cell : {int64_t(-1), int64_t(16)}) {
+        bool threw = false;
+        try {
+            solve_mapped_maze(maze, 0, cell);
+        } catch (const std::invalid_argument&) {
+            threw = true;
+        }
+        expect(threw, "end outside the maze is rejected");
+    }
+}
+
+} // namespace
+
+int main()
+{
+    header_larger_than_file();
+    open_border();
+    one_sided_wall();
+    endpoints_outside();
+    std::remove(PATH);
+    if (failures == 0) std::printf("maze_file_test: ok\n");
+    return failures == 0 ? 0 : 1;
+}
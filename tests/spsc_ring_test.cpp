@@ -0,0 +1,62 @@
+// Regression checks for SpscRing, run by `make check`.
+#include "spsc_ring.hpp"
+
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+int failures = 0;
+
+void expect(bool condition, const char* what)
+{
+    if (!condition) {
+        std::printf("FAIL %s\n", what);
+        ++failures;
+    }
+}
+
+// clear() after a partial consume() must leave the ring empty and usable,
+// not replay stale slots through the consumer's cached tail.
+void clear_after_partial_consume()
+{
+    SpscRing<int> ring(4);
+    for (int i = 0; i < 4; ++i) ring.try_push(i);
+    std::vector<int> seen;
+    ring.consume([&](int value) { seen.push_back(value); }, 1);
+    expect(seen.size() == 1 && seen[0] == 0, "partial consume takes the oldest value");
+
+    ring.consume([&](int value) { seen.push_back(value); }, 3);
+    for (int i = 4; i < 7; ++i) ring.try_push(i);
+    ring.clear();
+    size_t after_clear = ring.consume([](int) {}, 16);
+    expect(after_clear == 0, "consume after clear finds nothing");
+
+    expect(ring.try_push(7), "push after clear succeeds");
+    seen.clear();
+    ring.consume([&](int value) { seen.push_back(value); }, 16);
+    expect(seen.size() == 1 && seen[0] == 7, "consume after clear sees only the new value");
+}
+
+// Filling the ring to capacity after clear() must work, i.e. head_ was not
+// pushed past tail_.
+void fill_after_clear()
+{
+    SpscRing<int> ring(4);
+    for (int i = 0; i < 4; ++i) ring.try_push(i);
+    ring.consume([](int) {}, 2);
+    ring.clear();
+    int pushed = 0;
+    while (pushed < 8 && ring.try_push(pushed)) ++pushed;
+    expect(pushed == static_cast<int>(ring.capacity()), "ring refills to capacity after clear");
+}
+
+} // namespace
+
+int main()
+{
+    clear_after_partial_consume();
+    fill_after_clear();
+    if (failures == 0) std::printf("spsc_ring_test: ok\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,409 @@
+// Benchmark suite: times every generator and solver headless across grid
+// sizes and writes the results as JSON for regression tracking.
+#include "fixed_maze.hpp"
+#include "maze_creators.hpp"
+#include "maze_solvers.hpp"
+#include "maze_utils.hpp"
+#include "perf_counters.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+namespace {
+
+constexpr uint64_t BENCH_SEED = 20240601;
+
+struct BenchOptions
+{
+    std::vector<int> sizes = {25, 64, 256, 1024, 4096, 8192};
+    double min_time = 0.25;     // keep repeating a case until this much time has passed
+    double budget = 30.0;       // skip sizes whose run time, extrapolated linearly, exceeds this
+    std::string out = "bench_results.json";
+    std::string filter;         // only run cases whose name contains this
+    std::vector<GridLayout> layouts = {GridLayout::RowMajor};
+};
+
+struct BenchResult
+{
+    std::string name;
+    std::string kind;
+    std::string algorithm;
+    std::string layout = "row-major";
+    int size = 0;
+    int64_t iterations = 0;
+    double seconds_per_run = 0.0;
+    double ns_per_cell = 0.0;
+    int64_t peak_rss_bytes = 0;
+    double allocations_per_run = 0.0;
+    double allocated_bytes_per_run = 0.0;
+    double cells_visited_per_run = 0.0;
+    int64_t frontier_peak = 0;
+};
+
+// Resets the kernel's peak-RSS watermark to the current RSS (Linux only), so
+// the next read reflects just the benchmark that follows.
+void reset_peak_rss()
+{
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs) clear_refs << "5";
+}
+
+int64_t peak_rss_bytes()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return std::atoll(line.c_str() + 6) * 1024;
+        }
+    }
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss;
+#else
+    return static_cast<int64_t>(usage.ru_maxrss) * 1024;
+#endif
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Runs `body` until min_time has elapsed (at least once) and fills in the
+// per-run timing, allocation, memory and counter figures.
+template <class Setup, class Body>
+BenchResult measure(const BenchOptions& options, int size, Setup setup, Body body)
+{
+    BenchResult result;
+    result.size = size;
+    reset_peak_rss();
+
+    double elapsed = 0.0;
+    int64_t allocations = 0;
+    int64_t bytes = 0;
+    int64_t visited = 0;
+    perf_reset_peak();
+    while (result.iterations == 0 || elapsed < options.min_time) {
+        setup(result.iterations);
+        PerfSnapshot before = perf_snapshot();
+        auto start = std::chrono::steady_clock::now();
+        body();
+        elapsed += seconds_since(start);
+        PerfSnapshot after = perf_snapshot();
+        allocations += after.allocations - before.allocations;
+        bytes += after.allocated_bytes - before.allocated_bytes;
+        visited += after.cells_visited - before.cells_visited;
+        ++result.iterations;
+    }
+
+    double cells = static_cast<double>(size) * size;
+    result.seconds_per_run = elapsed / result.iterations;
+    result.ns_per_cell = result.seconds_per_run * 1e9 / cells;
+    result.peak_rss_bytes = peak_rss_bytes();
+    result.allocations_per_run = static_cast<double>(allocations) / result.iterations;
+    result.allocated_bytes_per_run = static_cast<double>(bytes) / result.iterations;
+    result.cells_visited_per_run = static_cast<double>(visited) / result.iterations;
+    result.frontier_peak = perf_snapshot().frontier_peak;
+    return result;
+}
+
+void print_result(const BenchResult& result)
+{
+    std::printf("%-34s %8lld it %12.6f s/run %9.2f ns/cell %9.1f MiB rss %12.0f allocs/run\n",
+                result.name.c_str(), static_cast<long long>(result.iterations), result.seconds_per_run,
+                result.ns_per_cell, result.peak_rss_bytes / (1024.0 * 1024.0), result.allocations_per_run);
+    std::fflush(stdout);
+}
+
+const char* layout_name(GridLayout layout)
+{
+    return layout == GridLayout::Tiled ? "tiled" : "row-major";
+}
+
+// Row-major cases keep their historical names; other layouts get a suffix.
+std::string case_name(const std::string& kind, const std::string& algorithm, int size, GridLayout layout)
+{
+    std::string name = kind + "/" + algorithm + "/" + std::to_string(size) + "x" + std::to_string(size);
+    if (layout != GridLayout::RowMajor) name += std::string("/") + layout_name(layout);
+    return name;
+}
+
+bool layout_fits(GridLayout layout, int size)
+{
+    return layout == GridLayout::RowMajor || size % CellLayout::TILE_SIDE == 0;
+}
+
+// Extrapolates the previous size's run time linearly in cell count. Quadratic
+// algorithms are underestimated, but this still stops them a size or two early.
+bool over_budget(const BenchOptions& options, const BenchResult& previous, int next_size)
+{
+    double ratio = (static_cast<double>(next_size) * next_size) / (static_cast<double>(previous.size) * previous.size);
+    return previous.seconds_per_run * ratio > options.budget;
+}
+
+bool selected(const BenchOptions& options, const std::string& name)
+{
+    return options.filter.empty() || name.find(options.filter) != std::string::npos;
+}
+
+std::vector<BenchResult> run_generators(const BenchOptions& options)
+{
+    std::vector<BenchResult> results;
+    for (const MazeCreatorInfo& info : maze_creator_list()) {
+        for (GridLayout layout : options.layouts) {
+            for (size_t size_index = 0; size_index < options.sizes.size(); ++size_index) {
+                int size = options.sizes[size_index];
+                std::string name = case_name("generate", info.name, size, layout);
+                if (!layout_fits(layout, size) || !selected(options, name)) continue;
+
+                Grid grid(size, size, layout);
+                uint64_t seed = BENCH_SEED;
+                BenchResult result = measure(options, size,
+                    [&](int64_t iteration) { seed = BENCH_SEED + static_cast<uint64_t>(iteration); },
+                    [&]() { info.create(grid, seed, NO_CELL, NO_CELL, nullptr); });
+                result.name = name;
+                result.kind = "generate";
+                result.algorithm = info.name;
+                result.layout = layout_name(layout);
+                print_result(result);
+                results.push_back(result);
+                if (size_index + 1 < options.sizes.size() && over_budget(options, result, options.sizes[size_index + 1])) {
+                    std::printf("%-34s skipping larger sizes, over the %.0f s budget\n", info.name, options.budget);
+                    break;
+                }
+            }
+        }
+    }
+    return results;
+}
+
+std::vector<BenchResult> run_solvers(const BenchOptions& options)
+{
+    std::vector<BenchResult> results;
+    const size_t solvers = maze_solver_list().size();
+    std::vector<bool> skipped(solvers * options.layouts.size(), false);
+    for (size_t size_index = 0; size_index < options.sizes.size(); ++size_index) {
+        int size = options.sizes[size_index];
+        for (size_t l = 0; l < options.layouts.size(); ++l) {
+            GridLayout layout = options.layouts[l];
+            if (!layout_fits(layout, size)) continue;
+            // Every solver works on the same fixed-seed DFS maze for a given
+            // size, which is the same maze in every layout.
+            Grid grid;
+            int32_t start_cell = NO_CELL;
+            int32_t end_cell = NO_CELL;
+
+            for (size_t s = 0; s < solvers; ++s) {
+                const MazeSolverInfo& info = maze_solver_list()[s];
+                std::string name = case_name("solve", info.name, size, layout);
+                if (skipped[l * solvers + s] || !selected(options, name)) continue;
+
+                if (grid.size() == 0) {
+                    grid = Grid(size, size, layout);
+                    create_dfs_maze(grid, BENCH_SEED, NO_CELL, NO_CELL, nullptr);
+                    start_cell = grid.index(0, 0);
+                    end_cell = grid.index(size - 1, size - 1);
+                }
+
+                BenchResult result = measure(options, size,
+                    [](int64_t) {},
+                    [&]() { info.solve(grid, start_cell, end_cell, nullptr); });
+                result.name = name;
+                result.kind = "solve";
+                result.algorithm = info.name;
+                result.layout = layout_name(layout);
+                print_result(result);
+                results.push_back(result);
+                if (size_index + 1 < options.sizes.size() && over_budget(options, result, options.sizes[size_index + 1])) {
+                    std::printf("%-34s skipping larger sizes, over the %.0f s budget\n", info.name, options.budget);
+                    skipped[l * solvers + s] = true;
+                }
+            }
+        }
+    }
+    return results;
+}
+
+// The compile-time kernels of fixed_maze.hpp, for the sizes instantiated
+// here. Their cases sit next to the dynamic ones of the same size, whose
+// results they reproduce.
+struct FixedKernels
+{
+    int size;
+    MazeCreator dfs;
+    MazeCreator prim;
+    SolveResult (*bfs)(const Grid&, int32_t, int32_t);
+};
+
+const FixedKernels FIXED_KERNELS[] = {
+    {25, create_fixed_dfs_maze<25, 25>, create_fixed_prim_maze<25, 25>, solve_fixed_bfs<25, 25>},
+    {64, create_fixed_dfs_maze<64, 64>, create_fixed_prim_maze<64, 64>, solve_fixed_bfs<64, 64>},
+};
+
+std::vector<BenchResult> run_fixed(const BenchOptions& options)
+{
+    std::vector<BenchResult> results;
+    for (const FixedKernels& kernels : FIXED_KERNELS) {
+        int size = kernels.size;
+        if (std::find(options.sizes.begin(), options.sizes.end(), size) == options.sizes.end()) continue;
+        for (GridLayout layout : options.layouts) {
+            if (!layout_fits(layout, size)) continue;
+            Grid grid(size, size, layout);
+            uint64_t seed = BENCH_SEED;
+            auto next_seed = [&](int64_t iteration) { seed = BENCH_SEED + static_cast<uint64_t>(iteration); };
+            auto add = [&](const char* kind, const char* algorithm, BenchResult result) {
+                result.name = case_name(kind, algorithm, size, layout);
+                result.kind = kind;
+                result.algorithm = algorithm;
+                result.layout = layout_name(layout);
+                print_result(result);
+                results.push_back(result);
+            };
+
+            if (selected(options, case_name("generate", "dfs-fixed", size, layout))) {
+                add("generate", "dfs-fixed", measure(options, size, next_seed,
+                    [&]() { kernels.dfs(grid, seed, NO_CELL, NO_CELL, nullptr); }));
+            }
+            if (selected(options, case_name("generate", "bfs-fixed", size, layout))) {
+                add("generate", "bfs-fixed", measure(options, size, next_seed,
+                    [&]() { kernels.prim(grid, seed, NO_CELL, NO_CELL, nullptr); }));
+            }
+            if (selected(options, case_name("solve", "bfs-fixed", size, layout))) {
+                create_dfs_maze(grid, BENCH_SEED, NO_CELL, NO_CELL, nullptr);
+                int32_t start_cell = grid.index(0, 0);
+                int32_t end_cell = grid.index(size - 1, size - 1);
+                add("solve", "bfs-fixed", measure(options, size, [](int64_t) {},
+                    [&]() { kernels.bfs(grid, start_cell, end_cell); }));
+            }
+        }
+    }
+    return results;
+}
+
+std::string json_escape(const std::string& text)
+{
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+bool write_json(const std::string& path, const std::vector<BenchResult>& results)
+{
+    std::ofstream out(path);
+    if (!out) return false;
+
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    out << "{\n  \"context\": {\n"
+        << "    \"date\": \"" << date << "\",\n"
+        << "    \"seed\": " << BENCH_SEED << ",\n"
+        << "    \"compiler\": \"" << json_escape(__VERSION__) << "\"\n"
+        << "  },\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << json_escape(r.name) << "\", "
+            << "\"kind\": \"" << r.kind << "\", "
+            << "\"algorithm\": \"" << json_escape(r.algorithm) << "\", "
+            << "\"layout\": \"" << r.layout << "\", "
+            << "\"width\": " << r.size << ", \"height\": " << r.size << ", "
+            << "\"iterations\": " << r.iterations << ", "
+            << "\"real_time_ns\": " << static_cast<int64_t>(r.seconds_per_run * 1e9) << ", "
+            << "\"ns_per_cell\": " << r.ns_per_cell << ", "
+            << "\"peak_rss_bytes\": " << r.peak_rss_bytes << ", "
+            << "\"allocations_per_run\": " << r.allocations_per_run << ", "
+            << "\"allocated_bytes_per_run\": " << static_cast<int64_t>(r.allocated_bytes_per_run) << ", "
+            << "\"cells_visited_per_run\": " << static_cast<int64_t>(r.cells_visited_per_run) << ", "
+            << "\"frontier_peak\": " << r.frontier_peak << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+    return static_cast<bool>(out);
+}
+
+std::vector<int> parse_sizes(const std::string& text)
+{
+    std::vector<int> sizes;
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        int size = std::atoi(item.c_str());
+        if (size > 0) sizes.push_back(size);
+    }
+    return sizes;
+}
+
+void print_usage(const char* program)
+{
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --sizes A,B,...     square grid sizes (default 25,64,256,1024,4096,8192)\n"
+              << "  --min-time SEC      repeat each case for at least this long (default 0.25)\n"
+              << "  --budget SEC        skip sizes predicted to take longer than this per run (default 30)\n"
+              << "  --filter TEXT       only run cases whose name contains TEXT\n"
+              << "  --layout NAME       grid layout: row-major, tiled or both (default row-major); tiled\n"
+              << "                      runs only sizes that are multiples of 64\n"
+              << "  --out PATH          JSON output file (default bench_results.json)\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    BenchOptions options;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            return 0;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (arg == "--sizes") options.sizes = parse_sizes(value);
+        else if (arg == "--min-time") options.min_time = std::atof(value.c_str());
+        else if (arg == "--budget") options.budget = std::atof(value.c_str());
+        else if (arg == "--filter") options.filter = value;
+        else if (arg == "--out") options.out = value;
+        else if (arg == "--layout" && (value == "row-major" || value == "tiled" || value == "both")) {
+            options.layouts.clear();
+            if (value != "tiled") options.layouts.push_back(GridLayout::RowMajor);
+            if (value != "row-major") options.layouts.push_back(GridLayout::Tiled);
+        }
+        else {
+            std::cerr << "Unknown option " << arg << "\n";
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::vector<BenchResult> results = run_generators(options);
+    std::vector<BenchResult> solver_results = run_solvers(options);
+    results.insert(results.end(), solver_results.begin(), solver_results.end());
+    std::vector<BenchResult> fixed_results = run_fixed(options);
+    results.insert(results.end(), fixed_results.begin(), fixed_results.end());
+
+    if (!write_json(options.out, results)) {
+        std::cerr << "Could not write " << options.out << "\n";
+        return 1;
+    }
+    std::cout << "Wrote " << results.size() << " results to " << options.out << "\n";
+    return 0;
+}
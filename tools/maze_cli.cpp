@@ -0,0 +1,719 @@
+// Headless front end: generates and solves mazes without opening a window.
+#include "maze_creators.hpp"
+#include "bitboard.hpp"
+#include "incremental_solver.hpp"
+#include "maze_file.hpp"
+#include "maze_solvers.hpp"
+#include "maze_stats.hpp"
+#include "maze_utils.hpp"
+#include "path_analysis.hpp"
+#include "perf_counters.hpp"
+#include "rng.hpp"
+#include "terrain.hpp"
+#include "trace.hpp"
+#include "tree_index.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct CliOptions
+{
+    int width = GRID_WIDTH;
+    int height = GRID_HEIGHT;
+    GridLayout layout = GridLayout::RowMajor;
+    std::string generator = "dfs";
+    std::string solver = "dijkstra";
+    std::string terrain;
+    uint64_t seed = 1;
+    int start_x = 0, start_y = 0;
+    int end_x = -1, end_y = -1;
+    int repeat = 1;
+    int threads = 0;
+    std::string save_path;
+    std::string load_path;
+    bool trace = false;
+    bool flood = false;
+    bool stats = false;
+    int edits = 0;
+    int64_t queries = 0;
+    int64_t batch = 0;
+    double braid = 0.0;
+    double open_walls = 0.0;
+    int k_paths = 0;
+    bool count_paths = false;
+    bool counters = false;
+    std::string chrome_trace;
+};
+
+struct PhaseStats
+{
+    double seconds = 0.0;
+    double min_seconds = 0.0;
+    double max_seconds = 0.0;
+
+    void add(double run_seconds, bool first)
+    {
+        seconds += run_seconds;
+        if (first || run_seconds < min_seconds) min_seconds = run_seconds;
+        if (first || run_seconds > max_seconds) max_seconds = run_seconds;
+    }
+};
+
+void print_usage(const char* program)
+{
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --size WxH          grid size (default " << GRID_WIDTH << "x" << GRID_HEIGHT << ")\n"
+              << "  --layout NAME       cell order in memory: row-major (default) or tiled (64x64 Morton\n"
+              << "                      tiles; width and height must be multiples of 64)\n"
+              << "  --generator NAME    maze generator:";
+    for (const MazeCreatorInfo& info : maze_creator_list()) std::cout << " " << info.name;
+    std::cout << " (default dfs)\n"
+              << "  --solver NAME       maze solver:";
+    for (const MazeSolverInfo& info : maze_solver_list()) std::cout << " " << info.name;
+    std::cout << " none (default dijkstra)\n"
+              << "  --terrain NAME      fill the cost layer before each run:";
+    for (const TerrainInfo& info : terrain_list()) std::cout << " " << info.name;
+    std::cout << "\n"
+              << "                      (dijkstra, astar and dial minimise cost; costs are not saved)\n"
+              << "  --braid F           after generating, remove the fraction F (0..1) of dead ends\n"
+              << "  --open-walls F      after generating, open the fraction F (0..1) of interior walls\n"
+              << "  --seed N            seed of the first run; run i uses N + i (default 1)\n"
+              << "  --start X,Y         solver start cell (default 0,0)\n"
+              << "  --end X,Y           solver end cell (default bottom-right corner)\n"
+              << "  --repeat N          number of mazes to generate and solve (default 1)\n"
+              << "  --threads N         worker threads for parallel algorithms (default: all cores)\n"
+              << "  --save PATH         write the maze to a .maze file; row-streaming generators\n"
+              << "                      write straight to the file without building a grid\n"
+              << "  --load PATH         solve a .maze file through a memory mapping instead of generating\n"
+              << "                      (mapped files are always solved with bfs)\n"
+              << "  --trace             run animated and record a playback trace; reports its size\n"
+              << "  --flood             time bitboard reachability and distance maps from the start cell\n"
+              << "  --stats             report dead ends, junctions, corridors, river factor, diameter and\n"
+              << "                      solution share of the last maze (streamed and mapped mazes get the\n"
+              << "                      counts of one pass over the rows)\n"
+              << "  --edits N           after the last run, apply N random edits (end moves and wall\n"
+              << "                      toggles) and compare incremental re-solves with full solves\n"
+              << "  --queries N         index the last maze as a tree and answer N random distance queries\n"
+              << "  --batch N           solve N random start/end pairs on the last maze in one batch, drawn\n"
+              << "                      from N/64 start cells, and compare with one solve per pair\n"
+              << "  --k-paths K         list the K cheapest loop-free start-end paths of the last maze (Yen)\n"
+              << "  --count-paths       count the cheapest start-end paths of the last maze\n"
+              << "  --counters          report cells visited, frontier peak, allocations and time per phase\n"
+              << "  --chrome-trace PATH write the generate/solve/analyse phases as Chrome trace JSON\n";
+}
+
+bool parse_pair(const char* text, char separator, int& a, int& b)
+{
+    char* rest = nullptr;
+    long first = std::strtol(text, &rest, 10);
+    if (rest == text || *rest != separator) return false;
+    const char* second_text = rest + 1;
+    long second = std::strtol(second_text, &rest, 10);
+    if (rest == second_text || *rest != '\0') return false;
+    a = static_cast<int>(first);
+    b = static_cast<int>(second);
+    return true;
+}
+
+bool parse_args(int argc, char* argv[], CliOptions& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            print_usage(argv[0]);
+            std::exit(0);
+        }
+        if (arg == "--trace") {
+            options.trace = true;
+            continue;
+        }
+        if (arg == "--flood") {
+            options.flood = true;
+            continue;
+        }
+        if (arg == "--stats") {
+            options.stats = true;
+            continue;
+        }
+        if (arg == "--count-paths") {
+            options.count_paths = true;
+            continue;
+        }
+        if (arg == "--counters") {
+            options.counters = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << arg << "\n";
+            return false;
+        }
+        const char* value = argv[++i];
+        if (arg == "--size") {
+            if (!parse_pair(value, 'x', options.width, options.height)) {
+                std::cerr << "Invalid --size '" << value << "', expected WxH\n";
+                return false;
+            }
+        } else if (arg == "--generator") {
+            options.generator = value;
+        } else if (arg == "--solver") {
+            options.solver = value;
+        } else if (arg == "--terrain") {
+            options.terrain = value;
+        } else if (arg == "--seed") {
+            options.seed = std::strtoull(value, nullptr, 10);
+        } else if (arg == "--start") {
+            if (!parse_pair(value, ',', options.start_x, options.start_y)) {
+                std::cerr << "Invalid --start '" << value << "', expected X,Y\n";
+                return false;
+            }
+        } else if (arg == "--end") {
+            if (!parse_pair(value, ',', options.end_x, options.end_y)) {
+                std::cerr << "Invalid --end '" << value << "', expected X,Y\n";
+                return false;
+            }
+        } else if (arg == "--layout") {
+            if (std::string(value) == "row-major") {
+                options.layout = GridLayout::RowMajor;
+            } else if (std::string(value) == "tiled") {
+                options.layout = GridLayout::Tiled;
+            } else {
+                std::cerr << "Unknown layout '" << value << "'\n";
+                return false;
+            }
+        } else if (arg == "--repeat") {
+            options.repeat = std::atoi(value);
+        } else if (arg == "--threads") {
+            options.threads = std::atoi(value);
+        } else if (arg == "--save") {
+            options.save_path = value;
+        } else if (arg == "--load") {
+            options.load_path = value;
+        } else if (arg == "--chrome-trace") {
+            options.chrome_trace = value;
+        } else if (arg == "--edits") {
+            options.edits = std::atoi(value);
+        } else if (arg == "--queries") {
+            options.queries = std::atoll(value);
+        } else if (arg == "--batch") {
+            options.batch = std::atoll(value);
+        } else if (arg == "--braid") {
+            options.braid = std::atof(value);
+        } else if (arg == "--open-walls") {
+            options.open_walls = std::atof(value);
+        } else if (arg == "--k-paths") {
+            options.k_paths = std::atoi(value);
+        } else {
+            std::cerr << "Unknown option " << arg << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report_phase(const char* name, const PhaseStats& stats, int runs, int64_t cells)
+{
+    double total_cells = static_cast<double>(cells) * runs;
+    std::printf("%-9s total %.6f s  avg %.6f s  min %.6f s  max %.6f s  %.3e cells/s\n",
+                name, stats.seconds, stats.seconds / runs, stats.min_seconds, stats.max_seconds,
+                stats.seconds > 0.0 ? total_cells / stats.seconds : 0.0);
+}
+
+// A negative time marks counts taken while the maze was generated.
+void report_stats(const MazeStats& stats, double seconds)
+{
+    std::vector<std::string> lines = maze_stats_lines(stats);
+    if (seconds < 0.0) std::printf("stats     during generation  %s\n", lines[0].c_str());
+    else std::printf("stats     %.6f s  %s\n", seconds, lines[0].c_str());
+    for (size_t i = 1; i < lines.size(); ++i) std::printf("          %s\n", lines[i].c_str());
+}
+
+// Solves a maze file in place through a memory mapping, so the maze never
+// has to fit in a Grid or even in memory.
+int solve_file(const CliOptions& options, const std::string& path)
+{
+    MappedMaze maze(path);
+    int end_x = options.end_x >= 0 ? options.end_x : maze.width() - 1;
+    int64_t end_y = options.end_y >= 0 ? options.end_y : maze.height() - 1;
+    if (options.start_x < 0 || options.start_y < 0 || options.start_x >= maze.width() || options.start_y >= maze.height()
+        || end_x >= maze.width() || end_y >= maze.height()) {
+        std::cerr << "Start and end must lie inside the maze\n";
+        return 1;
+    }
+    int64_t start_cell = maze.index(options.start_x, options.start_y);
+    int64_t end_cell = maze.index(end_x, end_y);
+
+    PhaseStats solve_stats;
+    MappedSolveResult result;
+    for (int run = 0; run < options.repeat; ++run) {
+        auto phase_start = std::chrono::steady_clock::now();
+        result = solve_mapped_maze(maze, start_cell, end_cell);
+        solve_stats.add(seconds_since(phase_start), run == 0);
+    }
+
+    std::printf("file %s  maze %dx%lld  generator %s  seed %llu  runs %d\n",
+                path.c_str(), maze.width(), static_cast<long long>(maze.height()), maze.generator().c_str(),
+                static_cast<unsigned long long>(maze.seed()), options.repeat);
+    report_phase("solve", solve_stats, options.repeat, maze.size());
+    std::printf("          path %zu cells  expanded %lld cells%s\n", result.path.size(),
+                static_cast<long long>(result.expanded), result.path.empty() ? "  unsolved" : "");
+
+    if (options.stats) {
+        auto phase_start = std::chrono::steady_clock::now();
+        MazeStats stats;
+        for (int64_t cell = 0; cell < maze.size(); ++cell) stats.add_cell(maze.walls(cell));
+        stats.solution_length = result.path.empty() ? -1 : static_cast<int32_t>(result.path.size()) - 1;
+        report_stats(stats, seconds_since(phase_start));
+    }
+    return 0;
+}
+
+// Generates with a row-streaming generator directly into a file.
+int stream_to_file(const CliOptions& options, const MazeCreatorInfo& creator, bool solve)
+{
+    PhaseStats generate_stats;
+    MazeStats stats;
+    for (int run = 0; run < options.repeat; ++run) {
+        uint64_t seed = options.seed + static_cast<uint64_t>(run);
+        auto phase_start = std::chrono::steady_clock::now();
+        MazeFileWriter writer(options.save_path, options.width, options.height, seed, creator.name);
+        if (options.stats && !solve) {
+            // The counts are taken from the rows on their way to the file.
+            stats = MazeStats();
+            creator.stream(options.width, options.height, seed, [&](int64_t, const uint8_t* walls) {
+                writer.write_row(walls);
+                stats.add_row(walls, options.width);
+            });
+        } else {
+            creator.stream(options.width, options.height, seed, writer.sink());
+        }
+        writer.finish();
+        generate_stats.add(seconds_since(phase_start), run == 0);
+    }
+
+    std::printf("grid %dx%d  generator %s  seed %llu  runs %d  streamed to %s\n",
+                options.width, options.height, creator.name, static_cast<unsigned long long>(options.seed), options.repeat,
+                options.save_path.c_str());
+    report_phase("generate", generate_stats, options.repeat, static_cast<int64_t>(options.width) * options.height);
+    if (solve) return solve_file(options, options.save_path);
+    if (options.stats) report_stats(stats, -1.0);
+    return 0;
+}
+
+// Alternately moves the end marker to a random cell and toggles a random
+// interior wall, re-solving after each edit both incrementally and from
+// scratch with `strategy`. Shortest paths may differ, so the two are
+// compared by cost; on a weighted grid the reference is Dijkstra, since the
+// incremental solver minimises cost and the BFS strategies do not.
+void run_edits(Grid& grid, int32_t start_cell, int32_t end_cell, SolveStrategy strategy, const CliOptions& options)
+{
+    if (grid.weighted()) strategy = SolveStrategy::Dijkstra;
+    Rng rng(options.seed);
+    IncrementalSolver solver(grid);
+    solver.solve(start_cell, end_cell);
+
+    PhaseStats incremental_stats;
+    PhaseStats full_stats;
+    int64_t incremental_expanded = 0;
+    int64_t full_expanded = 0;
+    int mismatches = 0;
+    for (int edit = 0; edit < options.edits; ++edit) {
+        int32_t cell = static_cast<int32_t>(rng.below(static_cast<uint32_t>(grid.size())));
+        if (edit % 2 == 0) {
+            end_cell = cell;
+        } else {
+            int dir = static_cast<int>(rng.below(4));
+            if (grid.neighbour(cell, dir) != NO_CELL) {
+                if (grid[cell].has_wall(dir)) grid.remove_wall(cell, dir);
+                else grid.add_wall(cell, dir);
+                solver.wall_changed(cell, dir);
+            }
+        }
+
+        auto phase_start = std::chrono::steady_clock::now();
+        SolveResult incremental = solver.solve(start_cell, end_cell);
+        incremental_stats.add(seconds_since(phase_start), edit == 0);
+        phase_start = std::chrono::steady_clock::now();
+        SolveResult full = solve_maze(grid, start_cell, end_cell, strategy);
+        full_stats.add(seconds_since(phase_start), edit == 0);
+
+        incremental_expanded += incremental.expanded;
+        full_expanded += full.expanded;
+        if (incremental.path.empty() != full.path.empty() || incremental.cost != full.cost) ++mismatches;
+    }
+
+    std::printf("edits     %d  incremental avg %.6f s  avg expanded %.1f  full avg %.6f s  avg expanded %.1f  mismatches %d\n",
+                options.edits, incremental_stats.seconds / options.edits,
+                static_cast<double>(incremental_expanded) / options.edits,
+                full_stats.seconds / options.edits, static_cast<double>(full_expanded) / options.edits, mismatches);
+}
+
+// Times the bitboard flood fills from the start cell against a scalar BFS
+// that expands the same cells.
+void run_flood(const Grid& grid, int32_t start_cell)
+{
+    auto phase_start = std::chrono::steady_clock::now();
+    PassageBitboard board(grid);
+    double build_seconds = seconds_since(phase_start);
+
+    phase_start = std::chrono::steady_clock::now();
+    std::vector<uint64_t> reachable = board.reachable(start_cell);
+    double reachable_seconds = seconds_since(phase_start);
+    int64_t reached = 0;
+    for (uint64_t word : reachable) reached += __builtin_popcountll(word);
+
+    phase_start = std::chrono::steady_clock::now();
+    DistanceMap map = board.distances(start_cell);
+    double distance_seconds = seconds_since(phase_start);
+
+    phase_start = std::chrono::steady_clock::now();
+    SolveResult scalar = solve_maze(grid, start_cell, map.farthest, SolveStrategy::BFS);
+    double scalar_seconds = seconds_since(phase_start);
+
+    std::printf("flood     board %.6f s  reachable %.6f s (%lld cells)  distances %.6f s  scalar bfs %.6f s (%lld cells)\n",
+                build_seconds, reachable_seconds, static_cast<long long>(reached), distance_seconds,
+                scalar_seconds, static_cast<long long>(scalar.expanded));
+    std::printf("          farthest cell %d,%d at distance %d\n", grid.x_of(map.farthest), grid.y_of(map.farthest),
+                map.max_distance);
+}
+
+// Builds the tree index over the final maze and times a batch of random
+// point-to-point distance queries against it.
+int run_queries(const Grid& grid, const CliOptions& options)
+{
+    auto phase_start = std::chrono::steady_clock::now();
+    std::unique_ptr<MazeTreeIndex> index;
+    try {
+        index = std::make_unique<MazeTreeIndex>(grid);
+    } catch (const std::invalid_argument& error) {
+        std::cerr << error.what() << "\n";
+        return 1;
+    }
+    double build_seconds = seconds_since(phase_start);
+
+    size_t count = static_cast<size_t>(options.queries);
+    std::vector<int32_t> starts(count);
+    std::vector<int32_t> ends(count);
+    std::vector<int32_t> distances(count);
+    Rng rng(options.seed);
+    for (size_t i = 0; i < count; ++i) {
+        starts[i] = static_cast<int32_t>(rng.below(static_cast<uint32_t>(grid.size())));
+        ends[i] = static_cast<int32_t>(rng.below(static_cast<uint32_t>(grid.size())));
+    }
+
+    phase_start = std::chrono::steady_clock::now();
+    index->distances(starts.data(), ends.data(), distances.data(), count);
+    double query_seconds = seconds_since(phase_start);
+
+    int64_t total = 0;
+    for (int32_t distance : distances) total += distance;
+    std::printf("queries   %lld  index %.6f s  batch %.6f s  %.3e queries/s  avg distance %.1f\n",
+                static_cast<long long>(count), build_seconds, query_seconds,
+                query_seconds > 0.0 ? count / query_seconds : 0.0,
+                count > 0 ? static_cast<double>(total) / count : 0.0);
+    return 0;
+}
+
+// Solves random start/end pairs with solve_batch. Starts come from a pool
+// of N/64 cells, so most searches serve many queries. The first few
+// hundred pairs are also solved one by one with BFS as a baseline.
+void run_batch(const Grid& grid, const CliOptions& options)
+{
+    size_t count = static_cast<size_t>(options.batch);
+    uint32_t source_count = static_cast<uint32_t>(std::max<int64_t>(1, options.batch / 64));
+    Rng rng(options.seed);
+    std::vector<int32_t> sources(source_count);
+    for (int32_t& source : sources) source = static_cast<int32_t>(rng.below(static_cast<uint32_t>(grid.size())));
+    std::vector<PathQuery> queries(count);
+    for (PathQuery& query : queries) {
+        query.start_cell = sources[rng.below(source_count)];
+        query.end_cell = static_cast<int32_t>(rng.below(static_cast<uint32_t>(grid.size())));
+    }
+
+    auto phase_start = std::chrono::steady_clock::now();
+    BatchSolveResult batch = solve_batch(grid, queries, false);
+    double batch_seconds = seconds_since(phase_start);
+
+    size_t single_count = std::min<size_t>(count, 256);
+    int64_t single_expanded = 0;
+    int mismatches = 0;
+    phase_start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < single_count; ++i) {
+        SolveResult single = solve_maze(grid, queries[i].start_cell, queries[i].end_cell, SolveStrategy::BFS);
+        single_expanded += single.expanded;
+        if (static_cast<int32_t>(single.path.size()) - 1 != batch.lengths[i]) ++mismatches;
+    }
+    double single_seconds = seconds_since(phase_start);
+
+    std::printf("batch     %lld queries  %lld searches  %.6f s  %.3e queries/s  avg expanded %.1f per query\n",
+                static_cast<long long>(count), static_cast<long long>(batch.searches), batch_seconds,
+                batch_seconds > 0.0 ? count / batch_seconds : 0.0,
+                count > 0 ? static_cast<double>(batch.expanded) / count : 0.0);
+    std::printf("          one by one %.3e queries/s  avg expanded %.1f per query  mismatches %d (first %zu)\n",
+                single_seconds > 0.0 ? single_count / single_seconds : 0.0,
+                single_count > 0 ? static_cast<double>(single_expanded) / single_count : 0.0, mismatches, single_count);
+}
+
+// Loop-aware path queries on the last maze: Yen's k cheapest paths and the
+// number of cheapest paths.
+void run_paths(const Grid& grid, int32_t start_cell, int32_t end_cell, const CliOptions& options)
+{
+    if (options.k_paths > 0) {
+        auto phase_start = std::chrono::steady_clock::now();
+        std::vector<SolveResult> paths = k_shortest_paths(grid, start_cell, end_cell, options.k_paths);
+        double seconds = seconds_since(phase_start);
+        int64_t expanded = 0;
+        for (const SolveResult& path : paths) expanded += path.expanded;
+        std::printf("k-paths   %zu of %d found  %.6f s  %lld cells expanded\n", paths.size(), options.k_paths, seconds,
+                    static_cast<long long>(expanded));
+        for (size_t i = 0; i < paths.size(); ++i) {
+            std::printf("          #%zu cost %lld  %zu cells\n", i + 1, static_cast<long long>(paths[i].cost),
+                        paths[i].path.size());
+        }
+    }
+    if (options.count_paths) {
+        auto phase_start = std::chrono::steady_clock::now();
+        PathCount count = count_shortest_paths(grid, start_cell, end_cell);
+        double seconds = seconds_since(phase_start);
+        if (count.cost < 0) {
+            std::printf("count     end unreachable  %.6f s\n", seconds);
+        } else {
+            std::printf("count     %s%llu cheapest paths of cost %lld  %.6f s  %lld cells expanded\n",
+                        count.saturated ? "at least " : "", static_cast<unsigned long long>(count.count),
+                        static_cast<long long>(count.cost), seconds, static_cast<long long>(count.expanded));
+        }
+    }
+}
+
+// Cells visited, frontier peak, allocations and time per phase over a
+// whole invocation, from the core's counters.
+void report_counters(const PerfSnapshot& before, const PerfSnapshot& after)
+{
+    std::printf("counters  cells visited %lld  frontier peak %lld  allocations %lld (%.1f MiB)\n",
+                static_cast<long long>(after.cells_visited - before.cells_visited),
+                static_cast<long long>(after.frontier_peak),
+                static_cast<long long>(after.allocations - before.allocations),
+                static_cast<double>(after.allocated_bytes - before.allocated_bytes) / (1024.0 * 1024.0));
+    std::printf("         ");
+    for (int phase = 0; phase < PERF_PHASE_COUNT; ++phase) {
+        int64_t runs = after.phase_runs[phase] - before.phase_runs[phase];
+        if (runs == 0) continue;
+        std::printf(" %s %.6f s (%lld)", perf_phase_name(static_cast<PerfPhase>(phase)),
+                    static_cast<double>(after.phase_ns[phase] - before.phase_ns[phase]) * 1e-9, static_cast<long long>(runs));
+    }
+    std::printf("\n");
+}
+
+int run(CliOptions& options)
+{
+    const MazeCreatorInfo* creator_info = find_maze_creator_info(options.generator);
+    if (!creator_info) {
+        std::cerr << "Unknown generator '" << options.generator << "'\n";
+        return 1;
+    }
+    MazeCreator creator = creator_info->create;
+    const MazeSolverInfo* solver = nullptr;
+    if (options.solver != "none") {
+        solver = find_maze_solver(options.solver);
+        if (!solver) {
+            std::cerr << "Unknown solver '" << options.solver << "'\n";
+            return 1;
+        }
+    }
+
+    const TerrainInfo* terrain = nullptr;
+    if (!options.terrain.empty()) {
+        terrain = find_terrain(options.terrain);
+        if (!terrain) {
+            std::cerr << "Unknown terrain '" << options.terrain << "'\n";
+            return 1;
+        }
+        if (!options.load_path.empty() || (!options.save_path.empty() && creator_info->stream)) {
+            std::cerr << "--terrain needs a grid; it cannot be used with --load or a streamed --save\n";
+            return 1;
+        }
+    }
+    const bool add_loops = options.braid > 0.0 || options.open_walls > 0.0;
+    if (add_loops && (!options.load_path.empty() || (!options.save_path.empty() && creator_info->stream))) {
+        std::cerr << "--braid and --open-walls need a grid; they cannot be used with --load or a streamed --save\n";
+        return 1;
+    }
+
+    try {
+        if (!options.load_path.empty()) return solve_file(options, options.load_path);
+        if (!options.save_path.empty() && creator_info->stream) return stream_to_file(options, *creator_info, solver != nullptr);
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << "\n";
+        return 1;
+    }
+
+    if (options.end_x < 0 || options.end_y < 0) {
+        options.end_x = options.width - 1;
+        options.end_y = options.height - 1;
+    }
+
+    Grid grid;
+    try {
+        grid = Grid(options.width, options.height, options.layout);
+    } catch (const std::invalid_argument& error) {
+        std::cerr << error.what() << "\n";
+        return 1;
+    }
+    if (!grid.in_bounds(options.start_x, options.start_y) || !grid.in_bounds(options.end_x, options.end_y)) {
+        std::cerr << "Start and end must lie inside the grid\n";
+        return 1;
+    }
+    int32_t start_cell = grid.index(options.start_x, options.start_y);
+    int32_t end_cell = grid.index(options.end_x, options.end_y);
+
+    PhaseStats generate_stats;
+    PhaseStats solve_stats;
+    PhaseStats braid_stats;
+    int64_t walls_opened = 0;
+    int64_t expanded = 0;
+    int64_t path_cells = 0;
+    int64_t path_cost = 0;
+    int unsolved = 0;
+    int64_t trace_events = 0;
+    int64_t trace_bytes = 0;
+    int64_t trace_keyframes = 0;
+    for (int run = 0; run < options.repeat; ++run) {
+        uint64_t seed = options.seed + static_cast<uint64_t>(run);
+
+        // With --trace the algorithms run in animated mode, publishing every
+        // cell change into a Trace as the visualiser would record it.
+        std::unique_ptr<Trace> trace;
+        std::atomic<bool> running{true};
+        std::atomic<bool>* animate = nullptr;
+        if (options.trace) {
+            trace = std::make_unique<Trace>(grid);
+            grid.set_event_sink(trace.get());
+            animate = &running;
+        }
+
+        if (terrain) terrain->fill(grid, seed);
+        auto phase_start = std::chrono::steady_clock::now();
+        creator(grid, seed, start_cell, end_cell, animate);
+        generate_stats.add(seconds_since(phase_start), run == 0);
+        if (add_loops) {
+            phase_start = std::chrono::steady_clock::now();
+            if (options.braid > 0.0) walls_opened += braid_maze(grid, seed, options.braid);
+            if (options.open_walls > 0.0) walls_opened += open_random_walls(grid, seed, options.open_walls);
+            braid_stats.add(seconds_since(phase_start), run == 0);
+        }
+
+        if (solver) {
+            running = true;
+            phase_start = std::chrono::steady_clock::now();
+            SolveResult result = animate ? solve_maze(grid, start_cell, end_cell, solver->strategy, animate)
+                                         : solve_maze(grid, start_cell, end_cell, solver->strategy);
+            solve_stats.add(seconds_since(phase_start), run == 0);
+            expanded += result.expanded;
+            path_cells += static_cast<int64_t>(result.path.size());
+            path_cost += result.cost;
+            if (result.path.empty()) ++unsolved;
+        }
+
+        if (trace) {
+            grid.set_event_sink(nullptr);
+            trace_events += trace->size();
+            trace_bytes += static_cast<int64_t>(trace->encoded_bytes());
+            trace_keyframes += static_cast<int64_t>(trace->keyframe_count());
+        }
+    }
+
+    if (!options.save_path.empty()) {
+        try {
+            uint64_t last_seed = options.seed + static_cast<uint64_t>(options.repeat - 1);
+            save_maze(grid, options.save_path, last_seed, options.generator);
+        } catch (const std::exception& error) {
+            std::cerr << error.what() << "\n";
+            return 1;
+        }
+    }
+
+    std::printf("grid %dx%d  generator %s  solver %s  seed %llu  runs %d%s%s\n",
+                options.width, options.height, options.generator.c_str(),
+                options.solver.c_str(), static_cast<unsigned long long>(options.seed), options.repeat,
+                terrain ? "  terrain " : "", terrain ? terrain->name : "");
+    report_phase("generate", generate_stats, options.repeat, grid.size());
+    if (add_loops) {
+        report_phase("braid", braid_stats, options.repeat, grid.size());
+        std::printf("          avg %.1f walls opened\n", static_cast<double>(walls_opened) / options.repeat);
+    }
+    if (solver) {
+        report_phase("solve", solve_stats, options.repeat, grid.size());
+        std::printf("          avg path %.1f cells  avg cost %.1f  avg expanded %.1f cells  unsolved %d\n",
+                    static_cast<double>(path_cells) / options.repeat, static_cast<double>(path_cost) / options.repeat,
+                    static_cast<double>(expanded) / options.repeat, unsolved);
+    }
+    if (options.trace) {
+        std::printf("trace     avg %.0f events  avg %.0f bytes (%.2f bytes/event)  avg %.1f keyframes\n",
+                    static_cast<double>(trace_events) / options.repeat,
+                    static_cast<double>(trace_bytes) / options.repeat,
+                    trace_events > 0 ? static_cast<double>(trace_bytes) / trace_events : 0.0,
+                    static_cast<double>(trace_keyframes) / options.repeat);
+    }
+    if (options.edits > 0) {
+        // The edits toggle walls, so they get a copy: the analyses below all
+        // run on the last maze as generated.
+        Grid edited = grid;
+        run_edits(edited, start_cell, end_cell, solver ? solver->strategy : SolveStrategy::BFS, options);
+    }
+    if (options.queries > 0 && run_queries(grid, options) != 0) return 1;
+    if (options.batch > 0) run_batch(grid, options);
+    if (options.flood) run_flood(grid, start_cell);
+    if (options.k_paths > 0 || options.count_paths) run_paths(grid, start_cell, end_cell, options);
+    if (options.stats) {
+        auto phase_start = std::chrono::steady_clock::now();
+        MazeStats stats = analyse_maze(grid, start_cell, end_cell);
+        report_stats(stats, seconds_since(phase_start));
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    CliOptions options;
+    if (!parse_args(argc, argv, options)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (options.width <= 0 || options.height <= 0 || options.repeat <= 0) {
+        std::cerr << "Size and repeat count must be positive\n";
+        return 1;
+    }
+
+    set_default_thread_count(options.threads);
+    perf_reset_peak();
+    if (!options.chrome_trace.empty()) perf_trace_start();
+    PerfSnapshot before = perf_snapshot();
+    int status = run(options);
+    if (options.counters) report_counters(before, perf_snapshot());
+    if (!options.chrome_trace.empty()) {
+        perf_trace_stop();
+        try {
+            perf_write_chrome_trace(options.chrome_trace);
+            std::printf("chrome trace: %zu events written to %s\n", perf_trace_size(), options.chrome_trace.c_str());
+        } catch (const std::exception& error) {
+            std::cerr << error.what() << "\n";
+            return 1;
+        }
+    }
+    return status;
+}